@@ -0,0 +1,327 @@
+/**
+@file           color.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists color spaces conversion.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "color.h"
+
+/**
+@addtogroup color
+@{
+*/
+
+#define COLOR_TABLE_SIZE                        256                             ///< Lightness tables entries quantity
+#define COLOR_TABLE_VALUE_TO_LIGHTNESS          0                               ///< Value to lightness table index
+#define COLOR_TABLE_LIGHTNESS_TO_VALUE          1                               ///< Lightness to value table index
+
+static const uint16_t lightness_tables[2][COLOR_TABLE_SIZE] = {
+  {                                                                             // Value to lightness
+        0,  1625,  2580,  3381,  4096,  4753,  5367,  5948,
+     6502,  7033,  7545,  8040,  8520,  8987,  9442,  9886,
+    10321, 10747, 11164, 11574, 11977, 12373, 12762, 13146,
+    13524, 13898, 14266, 14629, 14988, 15343, 15694, 16041,
+    16384, 16723, 17059, 17392, 17722, 18049, 18373, 18693,
+    19012, 19327, 19640, 19951, 20259, 20565, 20868, 21170,
+    21469, 21766, 22061, 22354, 22646, 22935, 23223, 23508,
+    23792, 24075, 24356, 24635, 24912, 25188, 25463, 25736,
+    26008, 26278, 26547, 26814, 27080, 27345, 27609, 27871,
+    28132, 28392, 28651, 28908, 29165, 29420, 29674, 29927,
+    30179, 30430, 30680, 30929, 31177, 31424, 31670, 31915,
+    32159, 32402, 32644, 32886, 33126, 33366, 33605, 33842,
+    34080, 34316, 34551, 34786, 35020, 35253, 35485, 35717,
+    35948, 36178, 36407, 36636, 36863, 37091, 37317, 37543,
+    37768, 37993, 38216, 38440, 38662, 38884, 39105, 39326,
+    39546, 39765, 39984, 40202, 40420, 40637, 40853, 41069,
+    41284, 41499, 41713, 41927, 42140, 42353, 42565, 42776,
+    42987, 43198, 43408, 43617, 43826, 44034, 44242, 44450,
+    44657, 44863, 45069, 45275, 45480, 45685, 45889, 46093,
+    46296, 46499, 46701, 46903, 47105, 47306, 47506, 47707,
+    47906, 48106, 48305, 48503, 48702, 48899, 49097, 49294,
+    49490, 49686, 49882, 50078, 50273, 50467, 50662, 50856,
+    51049, 51242, 51435, 51628, 51820, 52011, 52203, 52394,
+    52585, 52775, 52965, 53155, 53344, 53533, 53722, 53910,
+    54098, 54286, 54473, 54660, 54847, 55033, 55219, 55405,
+    55590, 55776, 55960, 56145, 56329, 56513, 56697, 56880,
+    57063, 57246, 57428, 57610, 57792, 57974, 58155, 58336,
+    58517, 58698, 58878, 59058, 59237, 59417, 59596, 59775,
+    59953, 60131, 60309, 60487, 60665, 60842, 61019, 61196,
+    61372, 61548, 61724, 61900, 62076, 62251, 62426, 62601,
+    62775, 62949, 63123, 63297, 63471, 63644, 63817, 63990,
+    64162, 64335, 64507, 64679, 64851, 65022, 65193, 65364
+  },
+  {                                                                             // Lightness to value
+        0,    16,    45,    83,   128,   179,   235,   296,
+      362,   432,   506,   584,   665,   750,   838,   930,
+     1024,  1121,  1222,  1325,  1431,  1540,  1651,  1765,
+     1881,  2000,  2121,  2245,  2371,  2499,  2629,  2762,
+     2896,  3033,  3172,  3313,  3456,  3601,  3748,  3897,
+     4048,  4200,  4355,  4511,  4670,  4830,  4992,  5155,
+     5321,  5488,  5657,  5827,  6000,  6173,  6349,  6526,
+     6705,  6885,  7067,  7251,  7436,  7623,  7811,  8001,
+     8192,  8385,  8579,  8775,  8972,  9170,  9370,  9572,
+     9775,  9979, 10185, 10392, 10601, 10811, 11022, 11235,
+    11448, 11664, 11880, 12098, 12318, 12538, 12760, 12984,
+    13208, 13434, 13661, 13889, 14119, 14350, 14582, 14815,
+    15049, 15285, 15522, 15760, 16000, 16240, 16482, 16725,
+    16969, 17215, 17461, 17709, 17958, 18208, 18459, 18711,
+    18964, 19219, 19475, 19732, 19989, 20248, 20509, 20770,
+    21032, 21296, 21560, 21826, 22093, 22360, 22629, 22899,
+    23170, 23442, 23715, 23989, 24265, 24541, 24818, 25097,
+    25376, 25656, 25938, 26220, 26504, 26788, 27074, 27360,
+    27648, 27936, 28226, 28516, 28808, 29100, 29393, 29688,
+    29983, 30280, 30577, 30875, 31175, 31475, 31776, 32078,
+    32381, 32685, 32990, 33296, 33603, 33911, 34220, 34529,
+    34840, 35151, 35464, 35777, 36092, 36407, 36723, 37040,
+    37358, 37677, 37996, 38317, 38639, 38961, 39284, 39609,
+    39934, 40260, 40587, 40914, 41243, 41572, 41903, 42234,
+    42566, 42899, 43233, 43568, 43903, 44240, 44577, 44915,
+    45254, 45594, 45935, 46276, 46619, 46962, 47306, 47651,
+    47996, 48343, 48690, 49038, 49388, 49737, 50088, 50440,
+    50792, 51145, 51499, 51854, 52209, 52566, 52923, 53281,
+    53640, 53999, 54360, 54721, 55083, 55446, 55809, 56173,
+    56539, 56905, 57271, 57639, 58007, 58376, 58746, 59117,
+    59488, 59860, 60233, 60607, 60981, 61357, 61733, 62110,
+    62487, 62866, 63245, 63624, 64005, 64386, 64769, 65151
+  }
+};                                                                              ///< Lightness tables (generated by tools/lightness_tables.py), entry i is the function of i/256
+
+static const uint8_t oklab_samples[COLOR_OKLAB_SAMPLES][3] = {
+  { 25,  33,  49}, {246, 250,  52}, {251,  35, 245}, { 45, 146, 144},
+  { 57,   9, 252}, {189,  15,  16}, {233, 189, 252}, {231, 139,  18},
+  { 21,  86,   6}, {  2,   1,   0}, { 53, 205,  38}, {137,  18, 150},
+  { 21, 248, 238}, {133, 113, 250}, { 31,  81, 137}, {254,  79, 122},
+  {105,  13,  46}, {141, 102,  18}, { 26,  11, 142}, {153,  88, 126},
+  { 98, 182, 252}, {233, 253, 228}, {184, 203, 139}, { 15, 150,  36},
+  {186, 146, 162}, {156,  27, 252}, {234, 125, 243}, { 66,  49,   9},
+  {207,  26, 151}, {  9,  99, 246}, {106, 254, 118}, { 30,   2,   7},
+  { 80,  16, 115}, {104,  73,  65}, { 25, 196, 163}, {146, 162,  39},
+  { 92,  64, 194}, { 39, 107,  92}, {208,  92,  56}, {  8,   4,  44},
+  {154,   5,  83}, {254, 166, 147}, { 91, 109, 178}, { 65,  50,  77},
+  { 25, 142, 245}, {245, 193,   6}, { 62,  14,  20}, {195,  97, 187},
+  {106,  63, 121}, {253,  23,  32}, {152, 216, 254}, { 41,   6,  89},
+  { 71,  12, 180}, {137, 133, 107}, {134,  36,  11}, { 10,  73,  74},
+  {165, 202,  34}, { 75, 110,  14}, {166, 147, 242}, {146,  75, 184},
+  { 14,  25,   5}, {207,  53,  93}, {  9,  65, 192}, {114, 149, 189},
+  {253, 131, 174}, {192,  75, 252}, {  5,  54, 112}, {249, 229, 139},
+  { 11,  49,   3}, {149, 169, 129}, {247, 117,  96}, {162, 246, 177},
+  {157,  73,  49}, {252,  82, 195}, {176,  13, 194}, {233, 210, 201},
+  {104,  80, 254}, { 16, 228, 148}, { 72,  16,  64}, {101, 104, 115},
+  {172, 128,  24}, {111,   6, 233}, { 35,   3,  44}, {114,  19,  98},
+  { 75, 167, 103}, { 85,  79,  10}, { 64,  53, 140}, {166, 186, 192},
+  {161,  52, 131}, { 59, 209, 226}, { 10,   9, 195}, {196, 107, 135},
+  {146, 115, 178}, {  5,  11,   8}, {199, 175,  62}, { 80, 127,  84},
+  { 51, 239,  38}, {118, 197, 112}, {250,  27, 143}, { 24, 171, 197},
+  {118,  47,  70}, {192, 142,  99}, {191, 232,  78}, {114, 138,  35},
+  { 12,  99, 183}, {  1,  10,  94}, {213, 154, 214}, { 10, 132, 188},
+  { 27,  51,  48}, {186, 114, 248}, { 38, 111, 142}, { 95,  44,  35},
+  {102,  98,  63}, {150, 103,  86}, {103,  31, 165}, {212,  39, 211},
+  {163, 248, 243}, { 84, 174,  33}, { 65,  83,  94}, {166,  56,  85},
+  { 44,  33,  20}, {113, 222, 189}, {134,  35, 198}, {166, 185, 254},
+  {245, 169,  85}, { 60,  69, 230}, {251,  90,   6}, { 27,  68,  31},
+  { 48,  33, 110}, {107, 127, 149}, { 83, 111, 238}, {117,  87, 149},
+  { 16,  35,  85}, {234,  89, 253}, {  1,   2,  20}, { 17,  47, 156},
+  {208,  73, 143}, {111, 139, 231}, {138, 225, 128}, { 70,  68,  47},
+  {  8,  22,  33}, {203, 175, 144}, {240, 198, 139}, {105, 180, 176},
+  {187, 127, 187}, {252, 155, 244}, {118,  95, 208}, {249,  19, 193},
+  {173, 254,  31}, {206, 254, 136}, {150,  84, 241}, {129,  77,  94},
+  { 68,  35,  39}, {253, 233, 255}, {205,  59,  47}, { 77,  86, 160},
+  {159,  24,  48}, {217, 183, 196}, {152, 116, 131}, {226, 144, 136},
+  {245,  20,  91}, {186,  65, 177}, {229, 109, 173}, { 23,  11,  66},
+  { 23, 251, 187}, {178, 220, 193}, { 51,  87,  57}, {177, 118,  80},
+  { 47,  29,  67}, {114, 156, 148}, {116,  61, 161}, { 36,  20,  29},
+  {227,  75,  84}, {209, 217, 254}, { 59,   4, 142}, {190,  16, 246},
+  {188,  87,  96}, { 28, 167, 250}, { 86,  46, 101}, {214, 114,  25},
+  { 77,  35, 219}, {149, 163, 214}, { 97, 225,  87}, {189, 150,  29},
+  { 50, 169, 150}, { 10, 147, 101}, { 16, 106,  56}, {132,  42, 120},
+  {160, 101, 212}, { 17,   6,  21}, { 91,  20,  10}, {  6,   9, 236},
+  {114,  65,  15}, {172,  91,  36}, { 27, 126, 123}, { 70,  68, 111},
+  {  5, 127,  44}, {169,  60, 217}, {188,   9,  68}, { 72,  95, 206},
+  {132,  14,  46}, { 28,  58,  81}, { 49,  22, 210}, {184,  13, 111},
+  { 24, 196, 118}, {218, 211, 100}, {251, 163, 193}, {109,   4, 131},
+  {137, 195, 162}, { 25, 115, 216}, {125, 122,  63}, {126,  64, 229},
+  {131, 187,  35}, {205, 121, 108}, {128,  83,   7}, {231, 111, 132},
+  {149, 164, 169}, { 55,   9,  46}, {102, 148, 108}, {214,  82, 215},
+  {251, 219,  24}, {222,  21, 115}, {247, 140,  85}, {109, 118, 100},
+  {150, 140, 152}, { 85,  87, 125}, { 95,  33,  73}, { 80,   7,  37},
+  {153,  46, 166}, {133,  70, 123}, { 59,  67, 171}, {145, 147,  72},
+  {101, 180, 132}, { 36, 189, 230}, {140,  59,  66}, { 81,  63,  79},
+  {160,  89, 166}, { 66,  30,  88}, {223,  18,  56}, { 91,   4,  83},
+  {227,  60, 175}, {  3,  39,  23}, { 78,  31, 145}, {232, 254, 181},
+  {  9, 152, 213}, {120, 191, 218}, {114, 119, 205}, {200, 133, 226},
+  { 98,  55, 235}, {152, 137, 205}, { 30,  69, 109}, { 44,  21, 175},
+  {213, 158,  94}, { 22,  23, 110}, {107, 255,  54}, {154, 233,  34}
+};                                                                              ///< OKLab gamut samples {R, G, B} (generated by tools/oklab_samples.py)
+
+/**
+@brief Fixed-point multiplication
+@param[in] a First multiplicand
+@param[in] b Second multiplicand (U16_MAX is about 1.0)
+@return a * b / 65536
+*/
+static uint16_t multiply(uint16_t a, uint16_t b){
+  return (((uint32_t) a) * b) >> 16;
+}
+
+/**
+@brief Hue offset within the sextant
+@details Calculates (a - b) * 65536 / delta. Difference is shifted as the unsigned magnitude, so 
+the difference of up to U16_MAX does not overflow the 32-bit signed value.
+@param[in] a Minuend channel value
+@param[in] b Subtrahend channel value
+@param[in] delta Difference of the maximal and the minimal channels values (not zero)
+@return Hue offset, -65536...65536
+*/
+static int32_t hue_offset(uint16_t a, uint16_t b, uint16_t delta){
+  if(a >= b) return (int32_t) ((((uint32_t) (uint16_t) (a - b)) << 16) / delta);
+  return -(int32_t) ((((uint32_t) (uint16_t) (b - a)) << 16) / delta);
+}
+
+/**
+@brief RGB to HSV conversion
+@param[in] rgb Color {R, G, B}
+@param[out] hsv Color {H, S, V}, hue and saturation of the achromatic color are zero
+@note This function uses division, it is intended to be called once per transition, not every tick
+*/
+void rgb_to_hsv(const uint16_t *rgb, uint16_t *hsv){
+  uint16_t max = rgb[0];
+  uint16_t min = rgb[0];
+  uint16_t delta;
+  int32_t hue;
+  for(uint8_t i = 1; i < 3; ++i){
+    if(rgb[i] > max) max = rgb[i];
+    if(rgb[i] < min) min = rgb[i];
+  }
+  delta = max - min;
+  hsv[2] = max;
+  if(!delta){                                                                   // Achromatic color
+    hsv[0] = 0;
+    hsv[1] = 0;
+    return;
+  }
+  hsv[1] = (delta == max) ? U16_MAX : (uint16_t) ((((uint32_t) delta) << 16) / max);
+  if(max == rgb[0]){                                                            // Hue in sextants, 65536 per sextant
+    hue = hue_offset(rgb[1], rgb[2], delta);
+  }else if(max == rgb[1]){
+    hue = 0x20000L + hue_offset(rgb[2], rgb[0], delta);
+  }else{
+    hue = 0x40000L + hue_offset(rgb[0], rgb[1], delta);
+  }
+  if(hue < 0) hue += 0x60000L;
+  hsv[0] = (uint16_t) (hue / 6);
+}
+
+/**
+@brief HSV to RGB conversion
+@details Conversion uses only multiplications, so it can be called every tick.
+@param[in] hsv Color {H, S, V}
+@param[out] rgb Color {R, G, B}
+*/
+void hsv_to_rgb(const uint16_t *hsv, uint16_t *rgb){
+  uint32_t sextant = ((uint32_t) hsv[0]) * 6;
+  uint16_t fraction = (uint16_t) sextant;                                       // Position inside the sextant
+  uint16_t v = hsv[2];
+  uint16_t p = multiply(v, U16_MAX - hsv[1]);
+  uint16_t q = multiply(v, U16_MAX - multiply(hsv[1], fraction));
+  uint16_t t = multiply(v, U16_MAX - multiply(hsv[1], U16_MAX - fraction));
+  switch((uint8_t) (sextant >> 16)){
+  case 0:
+    rgb[0] = v;
+    rgb[1] = t;
+    rgb[2] = p;
+    break;
+  case 1:
+    rgb[0] = q;
+    rgb[1] = v;
+    rgb[2] = p;
+    break;
+  case 2:
+    rgb[0] = p;
+    rgb[1] = v;
+    rgb[2] = t;
+    break;
+  case 3:
+    rgb[0] = p;
+    rgb[1] = q;
+    rgb[2] = v;
+    break;
+  case 4:
+    rgb[0] = t;
+    rgb[1] = p;
+    rgb[2] = v;
+    break;
+  default:
+    rgb[0] = v;
+    rgb[1] = p;
+    rgb[2] = q;
+    break;
+  }
+}
+
+/**
+@brief Lightness table lookup
+@details Linearly interpolates between table entries, the table end point is U16_MAX.
+@param[in] table Table index
+@param[in] x Function argument (0...U16_MAX)
+@return Function value (0...U16_MAX)
+*/
+static uint16_t table_lookup(uint8_t table, uint16_t x){
+  const uint16_t *entries = lightness_tables[table];
+  uint8_t index = (uint8_t) (x >> 8);
+  uint16_t next = (index == COLOR_TABLE_SIZE - 1) ? U16_MAX : entries[index + 1];
+  return entries[index] + (uint16_t) ((((uint32_t) (next - entries[index])) * (uint8_t) x) >> 8);
+}
+
+/**
+@brief Color channel value to apparent lightness conversion
+@param[in] value Color channel value
+@return Apparent lightness @f$l=v^{2/3}@f$ (output luminance is @f$v^2@f$, lightness is its cube 
+root by the Stevens' power law)
+*/
+uint16_t value_to_lightness(uint16_t value){
+  return table_lookup(COLOR_TABLE_VALUE_TO_LIGHTNESS, value);
+}
+
+/**
+@brief Apparent lightness to color channel value conversion
+@param[in] lightness Apparent lightness
+@return Color channel value @f$v=l^{3/2}@f$
+*/
+uint16_t lightness_to_value(uint16_t lightness){
+  return table_lookup(COLOR_TABLE_LIGHTNESS_TO_VALUE, lightness);
+}
+
+/**
+@brief OKLab gamut sample getter
+@details Samples are spread uniformly over the gamut in the OKLab color space, so random sample 
+index gives perceptually uniform random color.
+@param[in] index Sample index (0...COLOR_OKLAB_SAMPLES-1)
+@param[out] rgb Sample color {R, G, B}
+*/
+void get_oklab_sample(uint8_t index, uint16_t *rgb){
+  for(uint8_t i = 0; i < 3; ++i){
+    uint8_t value = oklab_samples[index][i];
+    rgb[i] = (((uint16_t) value) << 8) | value;                                 // 8-bit value scaling, 0xFF is U16_MAX
+  }
+}
+
+///@}
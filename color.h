@@ -0,0 +1,51 @@
+/**
+@file           color.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists color spaces conversion interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __COLOR_H__
+#define __COLOR_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup color Color spaces
+@brief This module consists fixed-point color spaces conversion
+@details HSV color is represented by three words {H, S, V}: hue full circle is 0...U16_MAX (so 
+hue arithmetics wraps around the circle naturally), saturation and value are 0...U16_MAX. 
+Apparent lightness of the color channel value is 0...U16_MAX too, conversions use flash-resident 
+tables.
+@{
+*/
+
+#define COLOR_OKLAB_SAMPLES                     256                             ///< OKLab gamut samples quantity
+
+void rgb_to_hsv(const uint16_t *rgb, uint16_t *hsv);
+void hsv_to_rgb(const uint16_t *hsv, uint16_t *rgb);
+uint16_t value_to_lightness(uint16_t value);
+uint16_t lightness_to_value(uint16_t lightness);
+void get_oklab_sample(uint8_t index, uint16_t *rgb);
+
+///@}
+
+#endif /* __COLOR_H__ */
@@ -0,0 +1,247 @@
+/**
+@file           command.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists serial commands handling.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "command.h"
+#include "protocol.h"
+#include "mood_logic.h"
+#include "config.h"
+#include "profiler.h"
+#include "hal.h"
+#include "palette.h"
+#include "scheduler.h"
+#include "sync.h"
+#include "strip.h"
+
+/**
+@addtogroup command
+@{
+*/
+
+#define COMMAND_STATE_SYNC_1                    0                               ///< Waiting for the first synchronization byte
+#define COMMAND_STATE_SYNC_2                    1                               ///< Waiting for the second synchronization byte
+#define COMMAND_STATE_TYPE                      2                               ///< Waiting for the frame type
+#define COMMAND_STATE_LENGTH                    3                               ///< Waiting for the payload length
+#define COMMAND_STATE_PAYLOAD                   4                               ///< Receiving payload
+#define COMMAND_STATE_CHECKSUM                  5                               ///< Waiting for the checksum
+
+static uint8_t state = COMMAND_STATE_SYNC_1;                                    ///< Frame parser state
+static uint8_t frame_type;                                                      ///< Received frame type
+static uint8_t frame_length;                                                    ///< Received frame payload length
+static uint8_t received;                                                        ///< Received payload bytes quantity
+static uint8_t checksum;                                                        ///< Received frame running checksum
+static uint8_t frame_payload[PROTOCOL_MAX_PAYLOAD_SIZE];                        ///< Received frame payload
+
+/**
+@brief Big-endian word reader
+@param[in] buffer Source pointer
+@return Read word
+*/
+static uint16_t get_word(const uint8_t *buffer){
+  return (((uint16_t) buffer[0]) << 8) | buffer[1];
+}
+
+/**
+@brief Command execution
+@details Executes received command. Commands with unknown type or wrong payload length are ignored. 
+Commands received by other interfaces (see @ref regmap) are executed by this function too, so they 
+are validated the same way.
+@param[in] type Command type (PROTOCOL_TYPE_...)
+@param[in] payload Pointer to the command payload
+@param[in] length Payload length, bytes
+*/
+void command_execute(uint8_t type, const uint8_t *payload, uint8_t length){
+  uint16_t color[3];
+  int16_t matrix[9];
+  uint32_t hold;
+  uint16_t address;
+  const uint8_t *p = payload;
+  uint8_t engine = 0;
+  switch(type){
+  case PROTOCOL_TYPE_SET_COLOR:
+    if(length == 7) engine = *p++;                                              // Optional instance number
+    if((p + 6 != payload + length) || (engine >= MOOD_ENGINES_NUMBER)) break;
+    for(uint8_t i = 0; i < 3; ++i){
+      color[i] = get_word(&p[2 * i]);
+    }
+    set_destination_color(&mood_engines[engine], color);
+    break;
+  case PROTOCOL_TYPE_SET_SPEED:
+    if(length != 2) break;
+    mood_config.color_flow_delay = get_word(payload);
+    break;
+  case PROTOCOL_TYPE_FREEZE:
+    if(length == 2) engine = *p++;                                              // Optional instance number
+    if((p + 1 != payload + length) || (engine >= MOOD_ENGINES_NUMBER)) break;
+    set_freeze(&mood_engines[engine], *p ? 1 : 0);
+    break;
+  case PROTOCOL_TYPE_SET_PROBABILITIES:
+    if(length != RGB_SCHEMES_NUMBER) break;
+    config_set_scheme_probabilities(payload);
+    break;
+  case PROTOCOL_TYPE_SET_HOLD:
+    if(length != 4) break;
+    mood_config.color_hold_ticks = (((uint32_t) get_word(payload)) << 16) | get_word(&payload[2]);
+    break;
+  case PROTOCOL_TYPE_SET_MATRIX:
+    if(length != 18) break;
+    for(uint8_t i = 0; i < 9; ++i){
+      matrix[i] = (int16_t) get_word(&payload[2 * i]);
+    }
+    config_set_color_matrix(matrix);
+    break;
+  case PROTOCOL_TYPE_SET_BRIGHTNESS:
+    if(length != 1) break;
+    mood_config.brightness = payload[0];                                        // Output stage ramps to the new value
+    break;
+  case PROTOCOL_TYPE_SET_INTERPOLATION:
+    if((length != 1) || (payload[0] >= RGB_INTERPOLATIONS_NUMBER)) break;
+    mood_config.interpolation = payload[0];                                     // Applied from the next transition
+    break;
+  case PROTOCOL_TYPE_SET_EASING:
+    if((length != 1) || (payload[0] > RGB_EASING_RANDOM)) break;
+    mood_config.easing = payload[0];                                            // Applied from the next transition
+    break;
+  case PROTOCOL_TYPE_SET_PACING:
+    if((length != 1) || (payload[0] >= RGB_PACINGS_NUMBER)) break;
+    mood_config.pacing = payload[0];                                            // Applied from the next transition
+    break;
+  case PROTOCOL_TYPE_SET_SAMPLING:
+    if((length != 1) || (payload[0] >= RGB_SAMPLINGS_NUMBER)) break;
+    mood_config.sampling = payload[0];                                          // Applied to the new lookahead queue colors
+    break;
+  case PROTOCOL_TYPE_SET_DISTANCE:
+    if(length != 2) break;
+    mood_config.min_distance = get_word(payload);
+    break;
+  case PROTOCOL_TYPE_SET_PALETTE:
+    if((length != 1) || (payload[0] >= PALETTES_NUMBER)) break;
+    mood_config.palette = payload[0];
+    break;
+  case PROTOCOL_TYPE_SET_SCHEDULER:
+    if((length != 1) || (payload[0] >= SCHEDULER_MODES_NUMBER)) break;
+    mood_config.scheduler = payload[0];
+    break;
+  case PROTOCOL_TYPE_SET_TRIM:
+    if((length != 1) || ((int8_t) payload[0] < HAL_CLK_TRIM_MIN) ||\
+      ((int8_t) payload[0] > HAL_CLK_TRIM_MAX)) break;
+    mood_config.hsi_trim = (int8_t) payload[0];
+    clk_trim(mood_config.hsi_trim);
+    break;
+  case PROTOCOL_TYPE_SET_HOLD_MS:
+    if((length != 4) || (mood_config.scheduler == SCHEDULER_LOOP)) break;       // Loop mode tick duration is unknown
+    hold = (((uint32_t) get_word(payload)) << 16) | get_word(&payload[2]);
+    if(hold > SCHEDULER_MAX_HOLD_MS) break;
+    mood_config.color_hold_ticks = scheduler_ms_to_steps(hold);
+    break;
+  case PROTOCOL_TYPE_SET_SYNC:
+    if((length != 1) || (payload[0] >= SYNC_ROLES_NUMBER)) break;
+    mood_config.sync_role = payload[0];
+    break;
+  case PROTOCOL_TYPE_SYNC:
+    if(length != SYNC_BEACON_SIZE) break;
+    sync_beacon(payload);
+    break;
+  case PROTOCOL_TYPE_SET_DMX:
+    if(length != 2) break;
+    address = get_word(payload);
+    if(address > HAL_DMX_UNIVERSE_SIZE - HAL_DMX_SLOTS + 1) break;
+    mood_config.dmx_address = address;
+    dmx_set_address(address);                                                   // Applied at once, the next break starts DMX512 mode
+    break;
+  case PROTOCOL_TYPE_SET_STRIP_LAG:
+    if((length != 1) || (payload[0] > STRIP_LAG_MAX)) break;
+    mood_config.strip_lag = payload[0];
+    break;
+  case PROTOCOL_TYPE_SET_STRIP_PERIOD:
+    if((length != 2) || (get_word(payload) < STRIP_PERIOD_MIN)) break;
+    mood_config.strip_period = get_word(payload);
+    break;
+  case PROTOCOL_TYPE_SAVE_CONFIG:
+    if(length != 0) break;
+    config_save();
+    profiler_restart();                                                         // EEPROM writing is not a part of the tick period
+    break;
+  default:                                                                      // Unknown command - do nothing
+    break;
+  }
+}
+
+/**
+@brief Received byte parsing
+@param[in] data Received byte
+*/
+static void command_parse(uint8_t data){
+  switch(state){
+  case COMMAND_STATE_SYNC_1:
+    if(data == PROTOCOL_SYNC_1) state = COMMAND_STATE_SYNC_2;
+    break;
+  case COMMAND_STATE_SYNC_2:
+    if(data == PROTOCOL_SYNC_2){
+      state = COMMAND_STATE_TYPE;
+    }else if(data != PROTOCOL_SYNC_1){                                          // Repeated first synchronization byte keeps synchronization
+      state = COMMAND_STATE_SYNC_1;
+    }
+    break;
+  case COMMAND_STATE_TYPE:
+    frame_type = data;
+    checksum = data;
+    state = COMMAND_STATE_LENGTH;
+    break;
+  case COMMAND_STATE_LENGTH:
+    frame_length = data;
+    checksum ^= data;
+    received = 0;
+    if(frame_length > PROTOCOL_MAX_PAYLOAD_SIZE){                               // Frame can not be a command, resynchronize
+      state = COMMAND_STATE_SYNC_1;
+    }else{
+      state = frame_length ? COMMAND_STATE_PAYLOAD : COMMAND_STATE_CHECKSUM;
+    }
+    break;
+  case COMMAND_STATE_PAYLOAD:
+    frame_payload[received++] = data;
+    checksum ^= data;
+    if(received == frame_length) state = COMMAND_STATE_CHECKSUM;
+    break;
+  default:                                                                      // Checksum
+    if(data == checksum) command_execute(frame_type, frame_payload, frame_length);
+    state = COMMAND_STATE_SYNC_1;
+    break;
+  }
+}
+
+/**
+@brief Commands handler
+@details Drains no more than COMMAND_DRAIN_BUDGET bytes from UART receiver buffer per call, so 
+commands flood can not stall the color flow. Remaining bytes are handled during the next ticks.
+@note This function should be called once per tick before mood lamp logic handler
+*/
+void command_handle(){
+  uint8_t data;
+  for(uint8_t budget = COMMAND_DRAIN_BUDGET; budget; --budget){
+    if(!uart_read(&data)) break;                                                // Receiver buffer is empty
+    command_parse(data);
+  }
+}
+
+///@}
@@ -0,0 +1,47 @@
+/**
+@file           command.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists serial commands handling interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __COMMAND_H__
+#define __COMMAND_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup command Commands
+@brief This module consists runtime control commands handling
+@details Commands are received by UART receiver interrupt handler into the lock-free receiver ring 
+buffer and are parsed and executed in the main cycle, so lamp state is never shared with interrupt 
+handlers. Frame format is described in protocol.h. I2C register map writes are executed as 
+commands too (see @ref regmap).
+@{
+*/
+
+#define COMMAND_DRAIN_BUDGET                    8                               ///< Maximal quantity of received bytes handled per tick
+
+void command_execute(uint8_t type, const uint8_t *payload, uint8_t length);
+void command_handle();
+
+///@}
+
+#endif /* __COMMAND_H__ */
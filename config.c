@@ -0,0 +1,241 @@
+/**
+@file           config.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists runtime configuration.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include "hal.h"
+#include "output.h"
+#include "palette.h"
+#include "scheduler.h"
+#include "sync.h"
+#include "dmx.h"
+#include "strip.h"
+
+/**
+@addtogroup config
+@{
+*/
+
+#define CONFIG_PAYLOAD_SIZE                     (RGB_SCHEMES_NUMBER + 40)       ///< Stored parameters length, bytes
+#define CONFIG_BLOCK_SIZE                       (3 + CONFIG_PAYLOAD_SIZE + 2)   ///< Whole configuration block length, bytes
+
+mood_config_t mood_config;                                                      ///< Runtime configuration
+
+/**
+@brief CRC-16/CCITT calculation
+@param[in] data Data pointer
+@param[in] length Data length, bytes
+@return CRC-16/CCITT (polynomial 0x1021, initial value 0xFFFF) of the data
+*/
+static uint16_t crc16(const uint8_t *data, uint8_t length){
+  uint16_t crc = 0xFFFF;
+  while(length--){
+    crc ^= ((uint16_t) *data++) << 8;
+    for(uint8_t i = 0; i < 8; ++i){
+      crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+@brief Compiled-in defaults loading
+*/
+static void config_defaults(){
+  static const uint8_t probabilities[RGB_SCHEMES_NUMBER] = {
+    RGB_ONE_COLOR_PROBABILITY,
+    RGB_TWO_COLORS_PROBABILITY,
+    RGB_THREE_COLORS_PROBABILITY,
+    RGB_ONE_COLOR_AND_RANDOM_PROBABILITY,
+    RGB_TWO_COLORS_AND_RANDOM_PROBABILITY
+  };
+  static const int16_t identity[9] = {
+    CONFIG_MATRIX_ONE, 0, 0,
+    0, CONFIG_MATRIX_ONE, 0,
+    0, 0, CONFIG_MATRIX_ONE
+  };
+  config_set_scheme_probabilities(probabilities);
+  mood_config.color_flow_delay = RGB_COLOR_FLOW_DELAY;
+  mood_config.color_hold_ticks = RGB_COLOR_HOLD_TICKS;
+  config_set_color_matrix(identity);
+  mood_config.brightness = OUTPUT_BRIGHTNESS;
+  mood_config.interpolation = RGB_INTERPOLATION;
+  mood_config.easing = RGB_EASING;
+  mood_config.pacing = RGB_PACING;
+  mood_config.sampling = RGB_SAMPLING;
+  mood_config.min_distance = RGB_MIN_DISTANCE;
+  mood_config.palette = RGB_PALETTE;
+  mood_config.scheduler = SCHEDULER_MODE;
+  mood_config.hsi_trim = 0;
+  mood_config.sync_role = SYNC_ROLE;
+  mood_config.dmx_address = DMX_ADDRESS;
+  mood_config.strip_lag = STRIP_LAG;
+  mood_config.strip_period = STRIP_PERIOD;
+}
+
+/**
+@brief Configuration loading
+@details Reads configuration block from EEPROM and checks its signature, version, length and 
+CRC. If any check fails or stored parameters are invalid, compiled-in defaults are used.
+@note This function should be called once at power-on
+*/
+void config_load(){
+  uint8_t block[CONFIG_BLOCK_SIZE];
+  int16_t matrix[9];
+  const uint8_t *p = &block[3];
+  eeprom_read(HAL_EEPROM_CONFIG_ADDRESS, block, CONFIG_BLOCK_SIZE);
+  if((block[0] != CONFIG_MAGIC) || (block[1] != CONFIG_VERSION) || (block[2] != CONFIG_PAYLOAD_SIZE) ||\
+    (crc16(block, CONFIG_BLOCK_SIZE - 2) != ((((uint16_t) block[CONFIG_BLOCK_SIZE - 2]) << 8) |\
+      block[CONFIG_BLOCK_SIZE - 1])) || !config_set_scheme_probabilities(p)){   // Block is absent or damaged
+    config_defaults();
+    return;
+  }
+  p += RGB_SCHEMES_NUMBER;
+  mood_config.color_flow_delay = (((uint16_t) p[0]) << 8) | p[1];
+  p += 2;
+  mood_config.color_hold_ticks = (((uint32_t) p[0]) << 24) | (((uint32_t) p[1]) << 16) |\
+    (((uint16_t) p[2]) << 8) | p[3];
+  p += 4;
+  for(uint8_t i = 0; i < 9; ++i){
+    matrix[i] = (int16_t) ((((uint16_t) p[0]) << 8) | p[1]);
+    p += 2;
+  }
+  config_set_color_matrix(matrix);
+  mood_config.brightness = *p++;
+  mood_config.interpolation = (*p < RGB_INTERPOLATIONS_NUMBER) ? *p : RGB_INTERPOLATION;
+  ++p;
+  mood_config.easing = (*p <= RGB_EASING_RANDOM) ? *p : RGB_EASING;
+  ++p;
+  mood_config.pacing = (*p < RGB_PACINGS_NUMBER) ? *p : RGB_PACING;
+  ++p;
+  mood_config.sampling = (*p < RGB_SAMPLINGS_NUMBER) ? *p : RGB_SAMPLING;
+  ++p;
+  mood_config.min_distance = (((uint16_t) p[0]) << 8) | p[1];
+  p += 2;
+  mood_config.palette = (*p < PALETTES_NUMBER) ? *p : RGB_PALETTE;
+  ++p;
+  mood_config.scheduler = (*p < SCHEDULER_MODES_NUMBER) ? *p : SCHEDULER_MODE;
+  ++p;
+  mood_config.hsi_trim = (((int8_t) *p >= HAL_CLK_TRIM_MIN) && ((int8_t) *p <= HAL_CLK_TRIM_MAX)) ? (int8_t) *p : 0;
+  ++p;
+  mood_config.sync_role = (*p < SYNC_ROLES_NUMBER) ? *p : SYNC_ROLE;
+  ++p;
+  mood_config.dmx_address = (((uint16_t) p[0]) << 8) | p[1];
+  if(mood_config.dmx_address > HAL_DMX_UNIVERSE_SIZE - HAL_DMX_SLOTS + 1) mood_config.dmx_address = DMX_ADDRESS;
+  p += 2;
+  mood_config.strip_lag = (*p <= STRIP_LAG_MAX) ? *p : STRIP_LAG;
+  ++p;
+  mood_config.strip_period = (((uint16_t) p[0]) << 8) | p[1];
+  if(mood_config.strip_period < STRIP_PERIOD_MIN) mood_config.strip_period = STRIP_PERIOD;
+}
+
+/**
+@brief Configuration saving
+@details Writes the current runtime configuration into EEPROM configuration block.
+@note This function blocks the main cycle during EEPROM writing, it should be called only by 
+explicit user request
+*/
+void config_save(){
+  uint8_t block[CONFIG_BLOCK_SIZE];
+  uint8_t *p = block;
+  uint16_t crc;
+  *p++ = CONFIG_MAGIC;
+  *p++ = CONFIG_VERSION;
+  *p++ = CONFIG_PAYLOAD_SIZE;
+  for(uint8_t i = 0; i < RGB_SCHEMES_NUMBER; ++i){
+    *p++ = mood_config.scheme_probabilities[i];
+  }
+  *p++ = (uint8_t) (mood_config.color_flow_delay >> 8);
+  *p++ = (uint8_t) mood_config.color_flow_delay;
+  *p++ = (uint8_t) (mood_config.color_hold_ticks >> 24);
+  *p++ = (uint8_t) (mood_config.color_hold_ticks >> 16);
+  *p++ = (uint8_t) (mood_config.color_hold_ticks >> 8);
+  *p++ = (uint8_t) mood_config.color_hold_ticks;
+  for(uint8_t i = 0; i < 3; ++i){
+    for(uint8_t j = 0; j < 3; ++j){
+      *p++ = (uint8_t) (((uint16_t) mood_config.color_matrix[i][j]) >> 8);
+      *p++ = (uint8_t) mood_config.color_matrix[i][j];
+    }
+  }
+  *p++ = mood_config.brightness;
+  *p++ = mood_config.interpolation;
+  *p++ = mood_config.easing;
+  *p++ = mood_config.pacing;
+  *p++ = mood_config.sampling;
+  *p++ = (uint8_t) (mood_config.min_distance >> 8);
+  *p++ = (uint8_t) mood_config.min_distance;
+  *p++ = mood_config.palette;
+  *p++ = mood_config.scheduler;
+  *p++ = (uint8_t) mood_config.hsi_trim;
+  *p++ = mood_config.sync_role;
+  *p++ = (uint8_t) (mood_config.dmx_address >> 8);
+  *p++ = (uint8_t) mood_config.dmx_address;
+  *p++ = mood_config.strip_lag;
+  *p++ = (uint8_t) (mood_config.strip_period >> 8);
+  *p++ = (uint8_t) mood_config.strip_period;
+  crc = crc16(block, CONFIG_BLOCK_SIZE - 2);
+  *p++ = (uint8_t) (crc >> 8);
+  *p = (uint8_t) crc;
+  eeprom_unlock();
+  eeprom_write(HAL_EEPROM_CONFIG_ADDRESS, block, CONFIG_BLOCK_SIZE);
+  eeprom_deinit();
+}
+
+/**
+@brief Color schemes shares setter
+@details Sets color schemes shares and calculates their total value, so mood lamp logic does not 
+sum shares every time it chooses the color scheme.
+@param[in] probabilities Color schemes shares, indexed by color scheme identifier
+@return 1 if shares were changed, 0 if all shares are zero (shares are not changed)
+*/
+uint8_t config_set_scheme_probabilities(const uint8_t *probabilities){
+  uint16_t sum = 0;
+  for(uint8_t i = 0; i < RGB_SCHEMES_NUMBER; ++i){
+    sum += probabilities[i];
+  }
+  if(!sum) return 0;                                                            // At least one scheme must be possible
+  for(uint8_t i = 0; i < RGB_SCHEMES_NUMBER; ++i){
+    mood_config.scheme_probabilities[i] = probabilities[i];
+  }
+  mood_config.scheme_probabilities_sum = sum;
+  return 1;
+}
+
+/**
+@brief Color correction matrix setter
+@details Sets color correction matrix and checks if it is identity, so output stage can skip 
+correction of the uncalibrated lamp.
+@param[in] matrix Q2.14 coefficients, 9 values row by row (row is the output channel)
+*/
+void config_set_color_matrix(const int16_t *matrix){
+  uint8_t identity = 1;
+  for(uint8_t i = 0; i < 3; ++i){
+    for(uint8_t j = 0; j < 3; ++j){
+      mood_config.color_matrix[i][j] = *matrix;
+      if(*matrix++ != ((i == j) ? CONFIG_MATRIX_ONE : 0)) identity = 0;
+    }
+  }
+  mood_config.color_matrix_identity = identity;
+}
+
+///@}
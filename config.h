@@ -0,0 +1,103 @@
+/**
+@file           config.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists runtime configuration interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+#include <stm8s.h>
+#include "mood_logic.h"
+
+/**
+@defgroup config Configuration
+@brief This module consists runtime-tunable mood lamp parameters
+@details Parameters are stored in the versioned configuration block at the end of EEPROM:
+@code
+offset  size  value
+0       1     CONFIG_MAGIC
+1       1     CONFIG_VERSION
+2       1     Payload length
+3       5     Color schemes shares
+8       2     Main cycle delay loop iterations
+10      4     Color hold time, ticks
+14      18    Color correction matrix coefficients, row by row
+32      1     Master brightness
+33      1     Interpolation mode
+34      1     Easing curve
+35      1     Pacing mode
+36      1     Sampling mode
+37      2     Minimal perceptual distance between new and recent colors
+39      1     Palette
+40      1     Scheduler mode
+41      1     HSI user trimming value
+42      1     Synchronization role
+43      2     DMX512 start address
+45      1     Addressable strip phase lag
+46      2     Addressable strip color history sampling period, color flow steps
+48      2     CRC-16/CCITT of all previous bytes
+@endcode
+Block is read once at power-on into the RAM structure, mood lamp logic reads parameters directly 
+from that structure. If block is absent, damaged or has another version, compiled-in defaults 
+from mood_logic.h and output.h are used.
+@{
+*/
+
+#define CONFIG_MAGIC                            0x4D                            ///< Configuration block signature
+#define CONFIG_VERSION                          17                              ///< Configuration block format version
+#define CONFIG_MATRIX_ONE                       0x4000                          ///< Color correction matrix coefficient 1.0 (Q2.14, coefficients are -2.0...+2.0)
+
+/**
+@brief Runtime configuration
+*/
+typedef struct{
+  uint8_t scheme_probabilities[RGB_SCHEMES_NUMBER];                             ///< Color schemes shares, indexed by color scheme identifier
+  uint16_t scheme_probabilities_sum;                                            ///< Color schemes shares total value (is not stored, calculated at loading)
+  uint16_t color_flow_delay;                                                    ///< Main cycle delay loop iterations (color flow speed regulation)
+  uint32_t color_hold_ticks;                                                    ///< Color hold time, ticks
+  int16_t color_matrix[3][3];                                                   ///< Color correction matrix, Q2.14 coefficients [output channel][input channel]
+  uint8_t color_matrix_identity;                                                ///< Color correction matrix is identity (is not stored, calculated at loading)
+  uint8_t brightness;                                                           ///< Master brightness (U8_MAX - full brightness)
+  uint8_t interpolation;                                                        ///< Interpolation mode of the new transitions
+  uint8_t easing;                                                               ///< Easing curve of the new transitions
+  uint8_t pacing;                                                               ///< Pacing mode of the new transitions
+  uint8_t sampling;                                                             ///< Random destination colors sampling mode
+  uint16_t min_distance;                                                        ///< Minimal perceptual distance between new and recent colors
+  uint8_t palette;                                                              ///< Palette of the palette sampling mode
+  uint8_t scheduler;                                                            ///< Main cycle scheduler mode
+  int8_t hsi_trim;                                                              ///< HSI user trimming value
+  uint8_t sync_role;                                                            ///< Multi-lamp synchronization role
+  uint16_t dmx_address;                                                         ///< DMX512 start address (0 - DMX512 reception is disabled)
+  uint8_t strip_lag;                                                            ///< Addressable strip phase lag between adjacent pixel groups, samples
+  uint16_t strip_period;                                                        ///< Addressable strip color history sampling period, color flow steps
+}mood_config_t;
+
+extern mood_config_t mood_config;
+
+void config_load();
+void config_save();
+uint8_t config_set_scheme_probabilities(const uint8_t *probabilities);
+void config_set_color_matrix(const int16_t *matrix);
+
+///@}
+
+#endif /* __CONFIG_H__ */
@@ -0,0 +1,84 @@
+/**
+@file           dmx.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists DMX512 control mode.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "dmx.h"
+#include "mood_logic.h"
+#include "config.h"
+#include "hal.h"
+
+/**
+@addtogroup dmx
+@{
+*/
+
+static uint16_t dmx_frames_handled = 0;                                         ///< Latched frames counter value at the previous handling
+static uint16_t dmx_idle_ticks = 0;                                             ///< Ticks since the last latched frame
+static uint8_t dmx_latching = 0;                                                ///< Frames are latched since DMX512 mode entering
+
+/**
+@brief DMX512 control mode initialization
+@details Sets the runtime configured DMX512 start address.
+*/
+void dmx_init(){
+  dmx_set_address(mood_config.dmx_address);
+}
+
+/**
+@brief DMX512 control mode handling
+@details Checks DMX512 signal loss and returns to the color flow after the timeout. Color flow 
+keeps running until the first frame is latched (see @ref hal_dmx), so a false break does not pause 
+it. Mood lamp logic instances colors are output again after returning.
+@param[in] ticks Ticks of the current main cycle pass
+@return 1 - PWM levels are set by DMX512 frames (mood lamp logic and the output stage should not be 
+handled), 0 - color flow mode
+*/
+uint8_t dmx_handle(uint16_t ticks){
+  uint16_t frames;
+  if(!dmx_is_active()){                                                         // Command mode or false break was rejected by HAL
+    dmx_idle_ticks = 0;
+    return 0;
+  }
+  frames = get_dmx_frames();
+  if(frames != dmx_frames_handled){
+    dmx_frames_handled = frames;
+    dmx_idle_ticks = 0;
+    dmx_latching = 1;
+    return 1;
+  }
+  dmx_idle_ticks = (ticks < DMX_TIMEOUT_TICKS - dmx_idle_ticks) ? dmx_idle_ticks + ticks : DMX_TIMEOUT_TICKS;
+  if(dmx_idle_ticks < DMX_TIMEOUT_TICKS) return dmx_latching;
+  dmx_idle_ticks = 0;
+  dmx_stop();
+  if(dmx_latching){
+    dmx_latching = 0;
+    for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){
+      mood_engines[i].output_changed = 1;                                       // PWM levels were changed by DMX512 frames
+    }
+  }
+  return 0;
+}
+
+///@}
@@ -0,0 +1,54 @@
+/**
+@file           dmx.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists DMX512 control mode headers.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef __DMX_H__
+#define __DMX_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup dmx DMX512
+@brief This module consists DMX512 control mode
+@details If DMX512 start address is set (see mood_config_t), the lamp is controlled by a DMX512 
+console connected to UART2 RX through RS-485 receiver: HAL_DMX_SLOTS slots beginning from the start 
+address set the PWM channels levels directly (see @ref hal_dmx). The first received break switches 
+UART2 into DMX512 mode, mood lamp logic instances and the output stage are paused from the first 
+latched frame (the frame after the qualifying one). If no frames are received for DMX_TIMEOUT_TICKS ticks, UART2 returns to the command mode 
+(115200 baud) and the color flow is resumed. Commands can not be received in DMX512 mode, so 
+DMX512 reception should be disabled (start address 0) before the lamp is connected to the command 
+line.
+@{
+*/
+
+#define DMX_ADDRESS                             0                               ///< Default DMX512 start address (DMX512 reception is disabled)
+#define DMX_TIMEOUT_TICKS                       9766                            ///< DMX512 signal loss timeout, ticks (~1.25s)
+
+void dmx_init();
+uint8_t dmx_handle(uint16_t ticks);
+
+///@}
+
+#endif /* __DMX_H__ */
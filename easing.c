@@ -0,0 +1,156 @@
+/**
+@file           easing.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists easing curves.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "easing.h"
+
+/**
+@addtogroup easing
+@{
+*/
+
+#define EASING_TABLE_SIZE                       256                             ///< Easing table entries quantity
+
+static const uint16_t easing_tables[EASINGS_NUMBER - 1][EASING_TABLE_SIZE] = {
+  {                                                                             // Smoothstep
+        0,     3,    12,    27,    47,    74,   106,   144,
+      188,   237,   292,   353,   418,   490,   567,   649,
+      736,   829,   926,  1029,  1137,  1251,  1369,  1492,
+     1620,  1753,  1891,  2033,  2180,  2332,  2489,  2650,
+     2816,  2986,  3161,  3340,  3523,  3711,  3903,  4100,
+     4300,  4504,  4713,  4926,  5142,  5363,  5587,  5816,
+     6048,  6284,  6523,  6767,  7013,  7264,  7518,  7775,
+     8036,  8300,  8568,  8838,  9112,  9390,  9670,  9953,
+    10240, 10529, 10822, 11117, 11415, 11716, 12020, 12327,
+    12636, 12948, 13262, 13579, 13898, 14220, 14544, 14871,
+    15200, 15531, 15864, 16200, 16537, 16877, 17219, 17562,
+    17908, 18255, 18604, 18955, 19308, 19663, 20019, 20376,
+    20736, 21096, 21459, 21822, 22187, 22553, 22921, 23290,
+    23660, 24031, 24403, 24776, 25150, 25525, 25901, 26278,
+    26656, 27034, 27413, 27793, 28173, 28554, 28935, 29317,
+    29700, 30082, 30465, 30849, 31232, 31616, 32000, 32384,
+    32768, 33151, 33535, 33919, 34303, 34686, 35070, 35453,
+    35835, 36218, 36600, 36981, 37362, 37742, 38122, 38501,
+    38879, 39257, 39634, 40010, 40385, 40759, 41132, 41504,
+    41875, 42245, 42614, 42982, 43348, 43713, 44076, 44439,
+    44799, 45159, 45516, 45872, 46227, 46580, 46931, 47280,
+    47627, 47973, 48316, 48658, 48998, 49335, 49671, 50004,
+    50335, 50664, 50991, 51315, 51637, 51956, 52273, 52587,
+    52899, 53208, 53515, 53819, 54120, 54418, 54713, 55006,
+    55295, 55582, 55865, 56145, 56423, 56697, 56967, 57235,
+    57499, 57760, 58017, 58271, 58522, 58768, 59012, 59251,
+    59487, 59719, 59948, 60172, 60393, 60609, 60822, 61031,
+    61235, 61435, 61632, 61824, 62012, 62195, 62374, 62549,
+    62719, 62885, 63046, 63203, 63355, 63502, 63644, 63782,
+    63915, 64043, 64166, 64284, 64398, 64506, 64609, 64706,
+    64799, 64886, 64968, 65045, 65117, 65182, 65243, 65298,
+    65347, 65391, 65429, 65461, 65488, 65508, 65523, 65532
+  },
+  {                                                                             // Sine in/out
+        0,     2,    10,    22,    39,    62,    89,   121,
+      158,   200,   246,   298,   355,   416,   482,   554,
+      630,   710,   796,   887,   982,  1082,  1187,  1297,
+     1411,  1530,  1654,  1782,  1915,  2053,  2196,  2343,
+     2494,  2650,  2811,  2976,  3146,  3320,  3499,  3682,
+     3869,  4061,  4257,  4457,  4662,  4871,  5084,  5301,
+     5522,  5748,  5977,  6211,  6448,  6690,  6935,  7185,
+     7438,  7695,  7956,  8220,  8488,  8760,  9036,  9315,
+     9597,  9883, 10173, 10466, 10762, 11062, 11365, 11671,
+    11980, 12292, 12608, 12926, 13248, 13572, 13900, 14230,
+    14563, 14899, 15237, 15578, 15922, 16268, 16616, 16968,
+    17321, 17677, 18035, 18395, 18758, 19122, 19489, 19857,
+    20228, 20600, 20975, 21351, 21728, 22108, 22489, 22872,
+    23256, 23641, 24028, 24416, 24806, 25196, 25588, 25981,
+    26375, 26770, 27166, 27562, 27960, 28358, 28756, 29156,
+    29556, 29956, 30357, 30758, 31160, 31561, 31963, 32365,
+    32767, 33170, 33572, 33974, 34375, 34777, 35178, 35579,
+    35979, 36379, 36779, 37177, 37575, 37973, 38369, 38765,
+    39160, 39554, 39947, 40339, 40729, 41119, 41507, 41894,
+    42279, 42663, 43046, 43427, 43807, 44184, 44560, 44935,
+    45307, 45678, 46046, 46413, 46777, 47140, 47500, 47858,
+    48214, 48567, 48919, 49267, 49613, 49957, 50298, 50636,
+    50972, 51305, 51635, 51963, 52287, 52609, 52927, 53243,
+    53555, 53864, 54170, 54473, 54773, 55069, 55362, 55652,
+    55938, 56220, 56499, 56775, 57047, 57315, 57579, 57840,
+    58097, 58350, 58600, 58845, 59087, 59324, 59558, 59787,
+    60013, 60234, 60451, 60664, 60873, 61078, 61278, 61474,
+    61666, 61853, 62036, 62215, 62389, 62559, 62724, 62885,
+    63041, 63192, 63339, 63482, 63620, 63753, 63881, 64005,
+    64124, 64238, 64348, 64453, 64553, 64648, 64739, 64825,
+    64905, 64981, 65053, 65119, 65180, 65237, 65289, 65335,
+    65377, 65414, 65446, 65473, 65496, 65513, 65525, 65533
+  },
+  {                                                                             // Exponential in/out
+        0,     2,     4,     6,     8,    10,    12,    15,
+       17,    20,    23,    26,    29,    33,    36,    40,
+       44,    48,    53,    58,    63,    68,    73,    79,
+       85,    92,    99,   106,   114,   122,   131,   140,
+      149,   159,   170,   181,   193,   206,   219,   233,
+      247,   263,   279,   297,   315,   334,   355,   376,
+      399,   423,   448,   475,   503,   533,   564,   598,
+      633,   670,   709,   750,   793,   839,   888,   939,
+      993,  1050,  1110,  1174,  1241,  1312,  1386,  1465,
+     1549,  1637,  1730,  1828,  1931,  2040,  2156,  2277,
+     2406,  2541,  2685,  2836,  2995,  3164,  3342,  3529,
+     3728,  3937,  4158,  4391,  4637,  4897,  5171,  5461,
+     5766,  6089,  6429,  6789,  7169,  7569,  7992,  8439,
+     8910,  9408,  9933, 10487, 11073, 11691, 12343, 13032,
+    13758, 14526, 15336, 16191, 17094, 18047, 19053, 20115,
+    21236, 22419, 23669, 24987, 26380, 27849, 29401, 31039,
+    32768, 34496, 36134, 37686, 39155, 40548, 41866, 43116,
+    44299, 45420, 46482, 47488, 48441, 49344, 50199, 51009,
+    51777, 52503, 53192, 53844, 54462, 55048, 55602, 56127,
+    56625, 57096, 57543, 57966, 58366, 58746, 59106, 59446,
+    59769, 60074, 60364, 60638, 60898, 61144, 61377, 61598,
+    61807, 62006, 62193, 62371, 62540, 62699, 62850, 62994,
+    63129, 63258, 63379, 63495, 63604, 63707, 63805, 63898,
+    63986, 64070, 64149, 64223, 64294, 64361, 64425, 64485,
+    64542, 64596, 64647, 64696, 64742, 64785, 64826, 64865,
+    64902, 64937, 64971, 65002, 65032, 65060, 65087, 65112,
+    65136, 65159, 65180, 65201, 65220, 65238, 65256, 65272,
+    65288, 65302, 65316, 65329, 65342, 65354, 65365, 65376,
+    65386, 65395, 65404, 65413, 65421, 65429, 65436, 65443,
+    65450, 65456, 65462, 65467, 65472, 65477, 65482, 65487,
+    65491, 65495, 65499, 65502, 65506, 65509, 65512, 65515,
+    65518, 65520, 65523, 65525, 65527, 65529, 65531, 65533
+  }
+};                                                                              ///< Easing curves tables (except constant velocity), entry i is the eased fraction at i/256
+
+/**
+@brief Easing curve application
+@param[in] curve Easing curve (EASING_LINEAR...EASING_EXPONENTIAL)
+@param[in] fraction Passed part of the transition time (0...U16_MAX)
+@return Passed part of the transition way (0...U16_MAX)
+*/
+uint16_t easing_apply(uint8_t curve, uint16_t fraction){
+  const uint16_t *table;
+  uint8_t index = (uint8_t) (fraction >> 8);
+  uint16_t next;
+  if((curve == EASING_LINEAR) || (curve >= EASINGS_NUMBER)) return fraction;
+  table = easing_tables[curve - 1];
+  next = (index == EASING_TABLE_SIZE - 1) ? U16_MAX : table[index + 1];         // The table end point is 1.0
+  return table[index] + (uint16_t) ((((uint32_t) (next - table[index])) * (uint8_t) fraction) >> 8);
+}
+
+///@}
@@ -0,0 +1,51 @@
+/**
+@file           easing.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists easing curves interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __EASING_H__
+#define __EASING_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup easing Easing curves
+@brief This module consists transition easing curves
+@details Easing curve maps the passed part of the transition time into the passed part of the 
+transition way. Curves are flash-resident 256-entry tables (generated by tools/easing_tables.py) 
+with linear interpolation between entries, so easing costs one table lookup and one word by byte 
+multiplication per tick.
+@{
+*/
+
+#define EASING_LINEAR                           0                               ///< Constant velocity
+#define EASING_SMOOTHSTEP                       1                               ///< Smoothstep @f$3t^2-2t^3@f$
+#define EASING_SINE                             2                               ///< Sine in/out @f$(1-cos(\pi t))/2@f$
+#define EASING_EXPONENTIAL                      3                               ///< Exponential in/out
+#define EASINGS_NUMBER                          4                               ///< Easing curves quantity
+
+uint16_t easing_apply(uint8_t curve, uint16_t fraction);
+
+///@}
+
+#endif /* __EASING_H__ */
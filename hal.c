@@ -29,14 +29,23 @@
 @{
 */
 
+static GPIO_TypeDef *const pwm_port[HAL_PWM_CHANNELS_MAX] = {
+  GPIOC, GPIOC, GPIOC, GPIOC, GPIOD, GPIOD, GPIOA, GPIOD, GPIOD
+};                                                                              ///< PWM logical channels output ports
+static const uint8_t pwm_pin[HAL_PWM_CHANNELS_MAX] = {
+  0x10, 0x08, 0x04, 0x02, 0x10, 0x08, 0x08, 0x04, 0x01
+};                                                                              ///< PWM logical channels output pins masks
+
 /**
 @brief GPIO initialization
-@details Initializes color PWM otput pins.
+@details Initializes color PWM otput pins of the used PWM channels.
 */
 void gpio_init(){
-  GPIOC->DDR |= HAL_GPIO_PINS_MASK;                                             // Output pins are outputs
-  GPIOC->CR1 |= HAL_GPIO_PINS_MASK;                                             // Push-pull
-  GPIOC->CR2 |= HAL_GPIO_PINS_MASK;                                             // High-speed
+  for(uint8_t i = 0; i < HAL_PWM_CHANNELS_NUMBER; ++i){
+    pwm_port[i]->DDR |= pwm_pin[i];                                             // Output pins are outputs
+    pwm_port[i]->CR1 |= pwm_pin[i];                                             // Push-pull
+    pwm_port[i]->CR2 |= pwm_pin[i];                                             // High-speed
+  }
 }
 
 ///@}
@@ -49,10 +58,36 @@ void gpio_init(){
 
 /**
 @brief MCU clock initialization
-@details Initializes MCU HSI as clock source with Fmcu = 16MHz
+@details Initializes MCU HSI as clock source with Fmcu = 16MHz and gates clocks of unused 
+peripherals (all peripherals are clocked after reset).
 */
 void clk_init(){
   CLK->CKDIVR = HAL_CLK_HSI_DIV_1_OUTPUT;                                       // Fcpu = Fclk = HSI/1
+  CLK->PCKENR1 = HAL_CLK_PCKENR1;
+  CLK->PCKENR2 = HAL_CLK_PCKENR2;
+}
+
+/**
+@brief CPU clock scaling
+@details Slows down the CPU clock while the main cycle sleeps, so interrupt handlers executed 
+during sleeping draw less current. Fmaster and all peripherals clocks are not changed.
+@param[in] slow 1 - Fcpu = Fmaster / 8, 0 - Fcpu = Fmaster
+*/
+void clk_cpu_slow(uint8_t slow){
+  CLK->CKDIVR = slow ? HAL_CLK_CPU_SLOW_DIV : HAL_CLK_HSI_DIV_1_OUTPUT;
+}
+
+/**
+@brief HSI user trimming
+@details Adds the user trimming value to the factory HSI calibration. The value is applied 
+immediately.
+@param[in] trim Trimming value (HAL_CLK_TRIM_MIN...HAL_CLK_TRIM_MAX, positive values speed HSI up)
+@note AWU period is measured against HSI at initialization, so it should be trimmed before 
+awu_init()
+*/
+void clk_trim(int8_t trim){
+  if((trim < HAL_CLK_TRIM_MIN) || (trim > HAL_CLK_TRIM_MAX)) return;
+  CLK->HSITRIMR = (uint8_t) trim & CLK_HSITRIMR_HSITRIM;                        // 3-bit two's complement value
 }
 
 ///@}
@@ -62,50 +97,860 @@ void clk_init(){
 @{
 */
 
+static volatile uint8_t *const pwm_ccr[HAL_PWM_CHANNELS_MAX] = {
+  &TIM1->CCR4H, &TIM1->CCR3H, &TIM1->CCR2H, &TIM1->CCR1H,
+  &TIM2->CCR1H, &TIM2->CCR2H, &TIM2->CCR3H,
+  &TIM3->CCR1H, &TIM3->CCR2H
+};                                                                              ///< PWM logical channels compare registers (high byte, low byte follows it)
+static volatile uint8_t *const pwm_ccmr[HAL_PWM_CHANNELS_MAX] = {
+  &TIM1->CCMR4, &TIM1->CCMR3, &TIM1->CCMR2, &TIM1->CCMR1,
+  &TIM2->CCMR1, &TIM2->CCMR2, &TIM2->CCMR3,
+  &TIM3->CCMR1, &TIM3->CCMR2
+};                                                                              ///< PWM logical channels compare mode registers
+static volatile uint16_t pwm_values[HAL_PWM_CHANNELS_NUMBER];                   ///< PWM logical channels shadow values
+static volatile uint8_t pwm_changed = 0;                                        ///< Shadow values change flag
+
 /**
-@brief PWM timer initialization
-@details Initializes PWM timer in left-aligned mode with Fpwm ~ 244Hz and 16 bit resolution.
+@brief PWM timers initialization
+@details Initializes PWM timers in left-aligned mode with Fpwm ~ 244Hz and 16 bit resolution. TIM2 
+and TIM3 are started only if their channels are used.
 */
 void pwm_init(){
-  TIM1->CCER1 = 0x10;                                                           // Timer channels 2, 3, 4 are on
+  TIM1->CCER1 = (HAL_PWM_CHANNELS_NUMBER > 3) ? 0x11 : 0x10;                    // Timer channels 2, 3, 4 (and 1) are on
   TIM1->CCER2 = 0x11;
-  TIM1->CCMR2 = 0x68;                                                           // Channels are PWM mode 1 outputs, preload registers are on
-  TIM1->CCMR3 = 0x68;
-  TIM1->CCMR4 = 0x68;
+  TIM1->CCMR1 = HAL_PWM_MODE;                                                   // Channels are PWM mode 1 outputs, preload registers are on
+  TIM1->CCMR2 = HAL_PWM_MODE;
+  TIM1->CCMR3 = HAL_PWM_MODE;
+  TIM1->CCMR4 = HAL_PWM_MODE;
   TIM1->CR1 |= 0x01;                                                            // Start timer
   TIM1->BKR |= 0x80;                                                            // Connect timer PWM outputs to GPIOs
+#if HAL_PWM_CHANNELS_NUMBER > 4
+  TIM2->CCER1 = (HAL_PWM_CHANNELS_NUMBER > 5) ? 0x11 : 0x01;                    // Timer channels 1 (2, 3) are on
+  TIM2->CCER2 = (HAL_PWM_CHANNELS_NUMBER > 6) ? 0x01 : 0x00;
+  TIM2->CCMR1 = HAL_PWM_MODE;                                                   // Channels are PWM mode 1 outputs, preload registers are on
+  TIM2->CCMR2 = HAL_PWM_MODE;
+  TIM2->CCMR3 = HAL_PWM_MODE;
+  TIM2->CR1 |= 0x01;                                                            // Start timer
+#endif
+#if HAL_PWM_CHANNELS_NUMBER > 7
+  TIM3->CCER1 = (HAL_PWM_CHANNELS_NUMBER > 8) ? 0x11 : 0x01;                    // Timer channels 1 (2) are on
+  TIM3->CCMR1 = HAL_PWM_MODE;                                                   // Channels are PWM mode 1 outputs, preload registers are on
+  TIM3->CCMR2 = HAL_PWM_MODE;
+  TIM3->CR1 |= 0x01;                                                            // Start timer
+#endif
 }
 
 /**
 @brief PWM level changing
-@details Sets PWM level on selected channel. Uses the pseudoexponential (quadratic) PWM level addiction for 
-apparent brightness linearization: @f$PWM=value^2/value_{max}@f$
-@param[in] channel Channel number (0...2)
-@param[in] value PWM channel value
+@details Sets PWM level on selected channel. Level is stored into the shadow value and is written 
+into the timer by pwm_update(). Apparent brightness linearization is made by the output stage.
+@param[in] channel Channel number (0...HAL_PWM_CHANNELS_NUMBER - 1)
+@param[in] value PWM channel level
 @note If invalid channel number received, no any changes makes
 */
 void set_rgbw_output_value(uint8_t channel, uint16_t value){
-  value = (((uint32_t) value) * value) >> 16;
-  switch(channel){
-  case 0:                                                                       // Red channel
-    TIM1->CCR4H = (uint8_t) (value >> 8);
-    TIM1->CCR4L = (uint8_t) value;
-    break;
-  case 1:                                                                       // Green channel
-    TIM1->CCR3H = (uint8_t) (value >> 8);
-    TIM1->CCR3L = (uint8_t) value;
-    break;
-  case 2:                                                                       // Blue channel
-    TIM1->CCR2H = (uint8_t) (value >> 8);
-    TIM1->CCR2L = (uint8_t) value;
-    break;
-  default:                                                                      // Everything else - do nothing
-    break;
+  if(channel >= HAL_PWM_CHANNELS_NUMBER) return;
+  pwm_values[channel] = value;
+  pwm_changed = 1;
+}
+
+/**
+@brief PWM levels updating
+@details Writes all shadow values into timers compare registers in one batch. Timers update events 
+are disabled during writing, so all channels of every timer change their levels at the same PWM 
+period. If no shadow value was changed since the last call, timers are not accessed.
+@note This function should be called once per tick after all outputs were set
+*/
+void pwm_update(){
+  if(!pwm_changed) return;
+  pwm_changed = 0;
+  TIM1->CR1 |= TIM1_CR1_UDIS;                                                   // Hold compare preload registers
+#if HAL_PWM_CHANNELS_NUMBER > 4
+  TIM2->CR1 |= TIM2_CR1_UDIS;
+#endif
+#if HAL_PWM_CHANNELS_NUMBER > 7
+  TIM3->CR1 |= TIM3_CR1_UDIS;
+#endif
+  for(uint8_t i = 0; i < HAL_PWM_CHANNELS_NUMBER; ++i){
+    volatile uint8_t *ccr = pwm_ccr[i];
+    uint16_t value = pwm_values[i];                                             // Single read: value may be latched by DMX512 receiver
+    ccr[0] = (uint8_t) (value >> 8);                                            // High byte must be written first
+    ccr[1] = (uint8_t) value;
+  }
+  TIM1->CR1 &= (uint8_t) ~TIM1_CR1_UDIS;                                        // Release compare preload registers
+#if HAL_PWM_CHANNELS_NUMBER > 4
+  TIM2->CR1 &= (uint8_t) ~TIM2_CR1_UDIS;
+#endif
+#if HAL_PWM_CHANNELS_NUMBER > 7
+  TIM3->CR1 &= (uint8_t) ~TIM3_CR1_UDIS;
+#endif
+}
+
+/**
+@brief Cycles counter getter
+@details PWM timer is clocked by Fmcu without prescaler, so its counter is used as a free-running 
+MCU cycles counter for time intervals measurement.
+@return Current PWM timer counter value
+@note Measured intervals must be shorter than the PWM period (65536 cycles, ~4ms)
+*/
+uint16_t get_cycles_counter(){
+  uint16_t value = ((uint16_t) TIM1->CNTRH) << 8;                               // High byte reading latches the low byte
+  return value | TIM1->CNTRL;
+}
+
+/**
+@brief PWM outputs static state check
+@details Outputs are static if every channel is turned off or (almost) fully turned on, so they can 
+be kept without PWM timers clocking.
+@return 1 if all PWM levels are static, 0 otherwise
+*/
+uint8_t pwm_is_static(){
+  for(uint8_t i = 0; i < HAL_PWM_CHANNELS_NUMBER; ++i){
+    if(pwm_values[i] && (pwm_values[i] < U16_MAX - HAL_PWM_STATIC_MARGIN)) return 0;
+  }
+  return 1;
+}
+
+/**
+@brief PWM outputs forcing
+@details Forces static outputs to their levels (turned on channels are forced high, turned off 
+channels are forced low) or returns them to PWM mode. Forced outputs do not depend on timers 
+counters, so timers can be stopped without outputs glitches.
+@param[in] force 1 - force static levels, 0 - return to PWM mode
+@note Outputs must be static (see pwm_is_static())
+*/
+void pwm_force_static(uint8_t force){
+  for(uint8_t i = 0; i < HAL_PWM_CHANNELS_NUMBER; ++i){
+    if(!force){
+      *pwm_ccmr[i] = HAL_PWM_MODE;
+    }else{
+      *pwm_ccmr[i] = pwm_values[i] ? HAL_PWM_FORCE_HIGH : HAL_PWM_FORCE_LOW;
+    }
   }
 }
 
 ///@}
 
+/**
+@addtogroup hal_uart
+@{
+*/
+
+static uint8_t uart_tx_buffer[HAL_UART_TX_BUFFER_SIZE];                         ///< Transmitter ring buffer
+static volatile uint8_t uart_tx_head = 0;                                       ///< Next byte to be written by the main cycle
+static volatile uint8_t uart_tx_tail = 0;                                       ///< Next byte to be transmitted by the interrupt handler
+static uint8_t uart_rx_buffer[HAL_UART_RX_BUFFER_SIZE];                         ///< Receiver ring buffer
+static volatile uint8_t uart_rx_head = 0;                                       ///< Next byte to be written by the interrupt handler
+static volatile uint8_t uart_rx_tail = 0;                                       ///< Next byte to be read by the main cycle
+static uint16_t dmx_address = 0;                                                ///< DMX512 start address (0 - DMX512 reception is disabled)
+static volatile uint8_t dmx_active = 0;                                         ///< UART2 is in DMX512 mode
+static volatile uint8_t dmx_qualified = 0;                                      ///< Complete null start code frame was received, the next frames are latched
+static uint16_t dmx_slot = HAL_DMX_IDLE;                                        ///< Next slot number (0 - start code)
+static uint8_t dmx_values[HAL_DMX_SLOTS];                                       ///< Collected slots of the current frame
+static volatile uint16_t dmx_frames = 0;                                        ///< Latched frames counter
+static volatile uint16_t dmx_errors = 0;                                        ///< Dropped frames counter
+
+/**
+@brief UART baud rate setting
+@param[in] divider Baud rate divider (Fmaster / baud rate)
+*/
+static void uart_set_divider(uint16_t divider){
+  UART2->BRR2 = (uint8_t) (((divider >> 8) & 0xF0) | (divider & 0x0F));         // BRR2 must be written before BRR1
+  UART2->BRR1 = (uint8_t) (divider >> 4);
+}
+
+/**
+@brief UART initialization
+@details Initializes UART2 in 8N1 mode with 115200 baud rate. TX pin is PD5, RX pin is PD6.
+*/
+void uart_init(){
+  uart_set_divider(HAL_UART_BAUDRATE_DIVIDER);
+  UART2->CR2 = UART2_CR2_TEN | UART2_CR2_REN | UART2_CR2_RIEN;                  // Transmitter and receiver are on, transmitter interrupt is enabled on demand
+}
+
+/**
+@brief Data transmission
+@details Puts data into the transmitter ring buffer, the transmitter interrupt handler sends it in 
+background. Data is written completely or not written at all, so function never waits for the 
+transmitter and never splits data blocks. Data is dropped in DMX512 mode (UART2 baud rate is 
+250000).
+@param[in] data Pointer to the data to be transmitted
+@param[in] length Data length, bytes
+@return 1 if data was put into the buffer, 0 if there is not enough free space in the buffer or 
+UART2 is in DMX512 mode
+*/
+uint8_t uart_write(const uint8_t *data, uint8_t length){
+  uint8_t head = uart_tx_head;
+  if(dmx_active) return 0;
+  if((uint8_t) (HAL_UART_TX_BUFFER_SIZE - 1 - ((uint8_t) (head - uart_tx_tail) &\
+    (HAL_UART_TX_BUFFER_SIZE - 1))) < length) return 0;                         // Not enough free space
+  while(length--){
+    uart_tx_buffer[head] = *data++;
+    head = (head + 1) & (HAL_UART_TX_BUFFER_SIZE - 1);
+  }
+  uart_tx_head = head;                                                          // Publish data only after it was copied
+  UART2->CR2 |= UART2_CR2_TIEN;                                                 // Start transmission
+  return 1;
+}
+
+/**
+@brief Received data reading
+@details Takes one byte from the receiver ring buffer. Receiver ring buffer is a single-producer 
+single-consumer queue: only the interrupt handler writes its head index and only this function 
+writes its tail index. Both indices are 8-bit, so they are read and written atomically and 
+interrupts never have to be disabled.
+@param[out] data Pointer to the received byte destination
+@return 1 if byte was read, 0 if the buffer is empty
+*/
+uint8_t uart_read(uint8_t *data){
+  uint8_t tail = uart_rx_tail;
+  if(tail == uart_rx_head) return 0;                                            // Nothing was received
+  *data = uart_rx_buffer[tail];
+  uart_rx_tail = (tail + 1) & (HAL_UART_RX_BUFFER_SIZE - 1);                    // Release the cell only after it was read
+  return 1;
+}
+
+/**
+@brief Received data presence check
+@return 1 if the receiver ring buffer is not empty, 0 otherwise
+*/
+uint8_t uart_rx_pending(){
+  return uart_rx_tail != uart_rx_head;
+}
+
+/**
+@brief Transmitter idle state check
+@return 1 if the transmitter ring buffer is empty and the last byte was completely sent, 0 otherwise
+*/
+uint8_t uart_tx_idle(){
+  return (uart_tx_tail == uart_tx_head) && (UART2->SR & UART2_SR_TC);
+}
+
+/**
+@brief UART transmitter interrupt handler
+@details Sends the next byte from the transmitter ring buffer or disables the transmitter interrupt 
+if the buffer is empty.
+*/
+INTERRUPT_HANDLER(uart2_tx_irq_handler, HAL_UART_TX_IRQ){
+  uint8_t tail = uart_tx_tail;
+  if(tail != uart_tx_head){
+    UART2->DR = uart_tx_buffer[tail];
+    uart_tx_tail = (tail + 1) & (HAL_UART_TX_BUFFER_SIZE - 1);
+  }else{
+    UART2->CR2 &= (uint8_t) ~UART2_CR2_TIEN;                                    // Nothing to send
+  }
+}
+
+/**
+@brief DMX512 mode leaving
+@details Returns UART2 to the command mode (115200 baud 8N1).
+@note Interrupts must be disabled
+*/
+static void dmx_leave(){
+  uart_set_divider(HAL_UART_BAUDRATE_DIVIDER);
+  UART2->CR3 = 0;
+  dmx_active = 0;
+  dmx_qualified = 0;
+  dmx_slot = HAL_DMX_IDLE;
+}
+
+/**
+@brief DMX512 slot receiving
+@details Collects used slots of the null start code frame and latches them into the PWM channels 
+shadow values after the last of them. Latched values are written into timers by the main cycle, 
+which is woken once per frame. The first complete frame after entering DMX512 mode only qualifies 
+the signal and is not latched. Damaged byte or alternate start code before that means a false 
+break (command mode bytes), so UART2 returns to the command mode.
+@param[in] status UART2 status register value
+@param[in] data Received byte
+*/
+static void dmx_receive(uint8_t status, uint8_t data){
+  uint16_t slot = dmx_slot;
+  if(status & (UART2_SR_OR | UART2_SR_FE)){                                     // Lost or damaged slot, frame is dropped
+    if(!dmx_qualified){
+      dmx_leave();
+      return;
+    }
+    if((slot != HAL_DMX_IDLE) && (dmx_errors < U16_MAX)) ++dmx_errors;
+    dmx_slot = HAL_DMX_IDLE;
+    return;
+  }
+  if(slot == HAL_DMX_IDLE) return;
+  if(!slot){                                                                    // Start code
+    if(!data){
+      dmx_slot = 1;
+    }else if(dmx_qualified){
+      dmx_slot = HAL_DMX_IDLE;                                                  // Alternate start code frames are not used
+    }else{
+      dmx_leave();
+    }
+    return;
+  }
+  if(slot >= dmx_address){
+    uint8_t i = (uint8_t) (slot - dmx_address);
+    dmx_values[i] = data;
+    if(i == HAL_DMX_SLOTS - 1){                                                 // The last used slot: latching
+      dmx_slot = HAL_DMX_IDLE;
+      if(!dmx_qualified){                                                       // Frame length check is passed
+        dmx_qualified = 1;
+        return;
+      }
+      for(i = 0; i < HAL_DMX_SLOTS; ++i){
+        uint8_t value = dmx_values[i];
+        pwm_values[i] = ((uint16_t) value) * value + (((uint16_t) value) << 1); // 255 is U16_MAX
+      }
+      pwm_changed = 1;
+      ++dmx_frames;
+      CFG->GCR &= (uint8_t) ~CFG_GCR_AL;                                        // Wake the main cycle
+      return;
+    }
+  }
+  dmx_slot = slot + 1;
+}
+
+/**
+@brief UART receiver interrupt handler
+@details Puts received byte into the receiver ring buffer. If the buffer is full, byte is dropped. 
+Sleeping main cycle is woken to handle the received command. If DMX512 start address is set, DMX512 
+breaks are detected and DMX512 mode bytes are parsed (see @ref hal_dmx).
+*/
+INTERRUPT_HANDLER(uart2_rx_irq_handler, HAL_UART_RX_IRQ){
+  uint8_t head = uart_rx_head;
+  uint8_t next = (head + 1) & (HAL_UART_RX_BUFFER_SIZE - 1);
+  uint8_t status = UART2->SR;                                                   // SR and DR reading sequence clears error flags
+  uint8_t data = UART2->DR;
+  if(dmx_address){
+    if((status & UART2_SR_FE) && !data){                                        // DMX512 break
+      if(!dmx_active){
+        uart_set_divider(HAL_DMX_BAUDRATE_DIVIDER);
+        UART2->CR3 = HAL_DMX_STOP_BITS;
+        clk_cpu_slow(0);                                                        // Cycle budget needs the full CPU clock
+        dmx_active = 1;
+        CFG->GCR &= (uint8_t) ~CFG_GCR_AL;                                      // Wake the main cycle to leave the low-power scheduling
+      }
+      dmx_slot = 0;
+      return;
+    }
+    if(dmx_active){
+      dmx_receive(status, data);
+      return;
+    }
+  }
+  if(next != uart_rx_tail){                                                     // Buffer is not full
+    uart_rx_buffer[head] = data;
+    uart_rx_head = next;                                                        // Publish byte only after it was written
+  }
+  CFG->GCR &= (uint8_t) ~CFG_GCR_AL;                                            // Wake the main cycle
+}
+
+///@}
+
+/**
+@addtogroup hal_dmx
+@{
+*/
+
+/**
+@brief DMX512 start address setting
+@param[in] address The first used slot number (1...HAL_DMX_UNIVERSE_SIZE - HAL_DMX_SLOTS + 1), 0 - 
+DMX512 reception is disabled (UART2 returns to the command mode if it is in DMX512 mode)
+*/
+void dmx_set_address(uint16_t address){
+  if(address > HAL_DMX_UNIVERSE_SIZE - HAL_DMX_SLOTS + 1) return;
+  if(!address) dmx_stop();
+  disableInterrupts();
+  dmx_address = address;
+  dmx_slot = HAL_DMX_IDLE;
+  enableInterrupts();
+}
+
+/**
+@brief DMX512 mode check
+@return 1 if UART2 is in DMX512 mode (PWM levels are set by DMX512 frames), 0 otherwise
+*/
+uint8_t dmx_is_active(){
+  return dmx_active;
+}
+
+/**
+@brief DMX512 mode stopping
+@details Returns UART2 to the command mode (115200 baud 8N1). DMX512 mode is started again by the 
+next received break.
+*/
+void dmx_stop(){
+  disableInterrupts();
+  if(dmx_active) dmx_leave();
+  enableInterrupts();
+}
+
+/**
+@brief Latched DMX512 frames counter getter
+@return Frames latched since power-on (wraps around)
+*/
+uint16_t get_dmx_frames(){
+  uint16_t frames;
+  disableInterrupts();
+  frames = dmx_frames;
+  enableInterrupts();
+  return frames;
+}
+
+/**
+@brief Dropped DMX512 frames counter getter
+@return Frames dropped because of overrun or framing errors since power-on (saturated at U16_MAX)
+*/
+uint16_t get_dmx_errors(){
+  uint16_t errors;
+  disableInterrupts();
+  errors = dmx_errors;
+  enableInterrupts();
+  return errors;
+}
+
+///@}
+
+/**
+@addtogroup hal_tick
+@{
+*/
+
+static volatile uint16_t tick_elapsed = 0;                                      ///< Ticks elapsed since the last tick_wait() return
+static volatile uint16_t tick_deadline = 0;                                     ///< Ticks to be elapsed before the main cycle wakeup
+static volatile uint8_t tick_chunk = 1;                                         ///< Ticks of the current timer period
+static volatile uint16_t tick_interrupts = 0;                                   ///< Timer interrupts counter
+
+/**
+@brief Tick timer initialization
+@details Configures TIM4 with one tick period and enables its update interrupt. Timer is started 
+by tick_run().
+*/
+void tick_init(){
+  TIM4->PSCR = HAL_TICK_PRESCALER;
+  TIM4->ARR = HAL_TICK_COUNTS - 1;
+  TIM4->EGR = TIM4_EGR_UG;                                                      // Load prescaler
+  TIM4->SR1 = 0;
+  TIM4->IER = TIM4_IER_UIE;
+  TIM4->CR1 = TIM4_CR1_URS;                                                     // Only overflow generates interrupt
+}
+
+/**
+@brief Tick timer starting and stopping
+@details Stops the timer and drops the elapsed ticks, then starts counting from the beginning of a 
+tick if required. So the first tick_wait() after the restart counts only the ticks elapsed since 
+the restart.
+@param[in] run 1 - timer runs, 0 - timer is stopped (does not wake the CPU)
+*/
+void tick_run(uint8_t run){
+  disableInterrupts();
+  TIM4->CR1 = TIM4_CR1_URS;
+  TIM4->CNTR = 0;
+  TIM4->ARR = HAL_TICK_COUNTS - 1;
+  TIM4->SR1 = 0;
+  tick_chunk = 1;
+  tick_elapsed = 0;
+  tick_deadline = 0;
+  if(run) TIM4->CR1 = TIM4_CR1_URS | TIM4_CR1_CEN;
+  enableInterrupts();
+}
+
+/**
+@brief Ticks waiting
+@details Puts the CPU into the wait mode until the specified number of ticks is elapsed since the 
+previous call return or until UART byte or I2C write transaction is received.
+@param[in] ticks Ticks to be elapsed since the previous call return
+@return Ticks actually elapsed since the previous call return (less than ticks if the main cycle 
+was woken by received data, may be greater if the main cycle was late)
+@note WFI instruction enables interrupts, so the wakeup interrupt can not be lost between the 
+deadline check and the wait mode entry
+*/
+uint16_t tick_wait(uint16_t ticks){
+  uint16_t elapsed;
+  disableInterrupts();
+  if((tick_elapsed < ticks) && !uart_rx_pending() && !i2c_write_pending()){     // Received data is handled without sleeping
+    tick_deadline = ticks;
+    CFG->GCR |= CFG_GCR_AL;                                                     // Interrupt handlers return to the wait mode
+    wfi();
+  }
+  disableInterrupts();
+  elapsed = tick_elapsed;
+  tick_elapsed = 0;
+  tick_deadline = 0;
+  enableInterrupts();
+  return elapsed;
+}
+
+/**
+@brief Tick timer interrupts counter getter
+@details Returns and resets the timer interrupts counter (CPU wakeups by the tick timer, AWU and 
+UART RX pin in the active-halt mode).
+@return Timer interrupts since the previous call
+*/
+uint16_t get_tick_interrupts(){
+  uint16_t interrupts;
+  disableInterrupts();
+  interrupts = tick_interrupts;
+  tick_interrupts = 0;
+  enableInterrupts();
+  return interrupts;
+}
+
+/**
+@brief Tick timer interrupt handler
+@details Counts elapsed ticks and programs the next timer period: the whole remaining sleep time 
+(no more than HAL_TICK_CHUNK_MAX ticks) or one tick if the main cycle does not sleep. Wakes the 
+main cycle when its deadline is reached. Counter has just been reloaded, so the new period is 
+applied immediately.
+*/
+INTERRUPT_HANDLER(tim4_upd_irq_handler, HAL_TICK_IRQ){
+  uint16_t elapsed = tick_elapsed + tick_chunk;
+  TIM4->SR1 = 0;
+  tick_elapsed = elapsed;
+  ++tick_interrupts;
+  if(elapsed >= tick_deadline){                                                 // Deadline is reached or the main cycle does not sleep
+    tick_chunk = 1;
+    CFG->GCR &= (uint8_t) ~CFG_GCR_AL;
+  }else{
+    uint16_t remaining = tick_deadline - elapsed;
+    tick_chunk = (remaining > HAL_TICK_CHUNK_MAX) ? HAL_TICK_CHUNK_MAX : (uint8_t) remaining;
+  }
+  TIM4->ARR = (uint8_t) (tick_chunk * HAL_TICK_COUNTS - 1);
+}
+
+///@}
+
+/**
+@addtogroup hal_awu
+@{
+*/
+
+static volatile uint8_t awu_rx_wakeup = 0;                                      ///< Active-halt mode was interrupted by incoming data (UART RX pin or I2C)
+static uint16_t awu_period = HAL_AWU_TICKS << 8;                                ///< Measured AWU period, 1/256 ticks
+static uint8_t awu_fraction = 0;                                                ///< Elapsed ticks fractional part
+
+/**
+@brief LSI measurement
+@details Captures every 8th LSI period by TIM3 clocked by Fmaster (HSI) and restores TIM3 and its 
+clock gating after measurement.
+@return Fmaster cycles of HAL_AWU_MEASURE_CAPTURES * 8 LSI periods, 0 if LSI is not captured
+*/
+static uint16_t awu_measure(){
+  uint16_t start = 0;
+  uint16_t cycles = 0;
+  CLK->PCKENR1 |= CLK_PCKENR1_TIM3;
+  AWU->CSR = AWU_CSR_MSR;                                                       // LSI is connected to TIM3 input capture 1
+  TIM3->CCMR1 = HAL_AWU_MEASURE_CCMR;
+  TIM3->CCER1 = TIM3_CCER1_CC1E;
+  TIM3->CR1 = TIM3_CR1_CEN;
+  for(uint8_t i = 0; i <= HAL_AWU_MEASURE_CAPTURES; ++i){
+    uint16_t capture;
+    uint16_t timeout = HAL_AWU_MEASURE_TIMEOUT;
+    while(!(TIM3->SR1 & TIM3_SR1_CC1IF) && --timeout);
+    if(!timeout){                                                               // LSI does not run
+      cycles = 0;
+      break;
+    }
+    capture = ((uint16_t) TIM3->CCR1H) << 8;                                    // Low byte reading clears capture flag
+    capture |= TIM3->CCR1L;
+    if(!i){
+      start = capture;
+    }else{
+      cycles = capture - start;
+    }
+  }
+  TIM3->CR1 = 0;
+  TIM3->CCER1 = 0;
+  TIM3->CCMR1 = 0;
+  TIM3->SR1 = 0;
+  TIM3->SR2 = 0;
+  AWU->CSR = 0;
+  CLK->PCKENR1 = HAL_CLK_PCKENR1;
+  return cycles;
+}
+
+/**
+@brief Auto-wakeup unit initialization
+@details Starts LSI, measures the AWU period, selects the low-power active-halt mode (main voltage 
+regulator and flash memory are off) and configures RX pin external interrupt sensitivity. If the 
+measured period is out of the LSI accuracy range, the nominal period is used.
+@note This function must be called while interrupts are disabled (external interrupt sensitivity 
+can be written only at this state) and before pwm_init() (TIM3 is used for measurement)
+*/
+void awu_init(){
+  uint16_t period;
+  CLK->ICKR |= CLK_ICKR_LSIEN | CLK_ICKR_SWUAH;                                 // LSI is on, main voltage regulator is off in active-halt mode
+  while(!(CLK->ICKR & CLK_ICKR_LSIRDY));
+  period = awu_measure() * (256 / (HAL_AWU_MEASURE_CAPTURES * 8));              // Fmaster cycles of LSI period are 1/256 ticks of AWU period
+  if((period >= (HAL_AWU_TICKS_MIN << 8)) && (period <= (HAL_AWU_TICKS_MAX << 8))) awu_period = period;
+  FLASH->CR1 |= FLASH_CR1_AHALT;                                                // Flash memory is powered down in active-halt mode
+  AWU->APR = HAL_AWU_APR;
+  AWU->TBR = HAL_AWU_TBR;
+  EXTI->CR1 = (EXTI->CR1 & (uint8_t) ~EXTI_CR1_PDIS) | HAL_AWU_RX_SENSITIVITY;
+}
+
+/**
+@brief Active-halt mode sleeping
+@details Halts the CPU for the whole AWU periods which fit into the specified number of ticks. 
+Sleeping is finished early if UART RX pin level falls (incoming byte start bit) or I2C address 
+matches.
+@param[in] ticks Maximal sleep time, ticks
+@return Ticks elapsed in the active-halt mode (the interrupted AWU period is counted as a half of 
+the period)
+@note PWM outputs must be static and forced (see pwm_force_static()), UART transmitter must be idle. 
+Elapsed time accuracy is the HSI accuracy (the AWU period is measured against HSI).
+*/
+uint16_t awu_halt(uint16_t ticks){
+  uint16_t elapsed = 0;
+  uint16_t period;
+  awu_rx_wakeup = 0;
+  GPIOD->CR2 |= HAL_AWU_RX_PIN;                                                 // Incoming byte start bit wakes the CPU
+  AWU->CSR = AWU_CSR_AWUEN;
+  while((uint16_t) (ticks - elapsed) > (awu_period >> 8)){                      // Whole AWU period fits
+    disableInterrupts();
+    if(awu_rx_wakeup) break;
+    halt();                                                                     // HALT instruction enables interrupts
+    period = awu_rx_wakeup ? (awu_period >> 1) : awu_period;                    // Interrupted period is credited by its expected part
+    period += awu_fraction;
+    elapsed += period >> 8;
+    awu_fraction = (uint8_t) period;
+  }
+  enableInterrupts();
+  AWU->CSR = 0;
+  GPIOD->CR2 &= (uint8_t) ~HAL_AWU_RX_PIN;
+  return elapsed;
+}
+
+/**
+@brief Active-halt interruption check
+@return 1 if the last active-halt sleeping was interrupted by incoming data, 0 otherwise
+*/
+uint8_t awu_is_interrupted(){
+  return awu_rx_wakeup;
+}
+
+/**
+@brief Auto-wakeup interrupt handler
+@details Clears the AWU flag and counts the CPU wakeup.
+*/
+INTERRUPT_HANDLER(awu_irq_handler, HAL_AWU_IRQ){
+  (void) AWU->CSR;                                                              // Reading clears the AWU flag
+  ++tick_interrupts;
+}
+
+/**
+@brief UART RX pin external interrupt handler
+@details Interrupts the active-halt mode sleeping. Pin interrupt is disabled at once, so UART 
+reception does not cause interrupts.
+*/
+INTERRUPT_HANDLER(exti_portd_irq_handler, HAL_AWU_RX_IRQ){
+  GPIOD->CR2 &= (uint8_t) ~HAL_AWU_RX_PIN;
+  awu_rx_wakeup = 1;
+  ++tick_interrupts;
+}
+
+///@}
+
+/**
+@addtogroup hal_i2c
+@{
+*/
+
+static uint8_t i2c_map[2][HAL_I2C_MAP_SIZE];                                    ///< Register map buffers
+static volatile uint8_t i2c_front = 0;                                          ///< Published register map buffer
+static volatile uint8_t i2c_bank = HAL_I2C_IDLE;                                ///< Register map buffer latched by the current read transaction
+static uint8_t i2c_pointer = 0;                                                 ///< Register pointer
+static uint8_t i2c_received = 0;                                                ///< Received bytes of the current write transaction (including the pointer)
+static uint8_t i2c_write_address;                                               ///< The first register of the collected write transaction
+static uint8_t i2c_write_data[HAL_I2C_WRITE_SIZE];                              ///< Collected write transaction data
+static volatile uint8_t i2c_write_length = 0;                                   ///< Collected data length, is published after the stop condition
+static volatile uint8_t i2c_write_ready = 0;                                    ///< Write transaction is passed to the main cycle
+static uint8_t i2c_collect = 0;                                                 ///< Current write transaction is collected (previous one was taken)
+
+/**
+@brief I2C initialization
+@details Initializes I2C as a slave with HAL_I2C_ADDRESS address, all events are handled by the 
+interrupt handler. SCL and SDA pins are true open-drain pins and do not need GPIO configuration.
+*/
+void i2c_init(){
+  I2C->FREQR = HAL_I2C_FREQR;
+  I2C->OARL = (uint8_t) (HAL_I2C_ADDRESS << 1);
+  I2C->OARH = I2C_OARH_ADDCONF;                                                 // ADDCONF bit must be set
+  I2C->ITR = I2C_ITR_ITEVTEN | I2C_ITR_ITERREN;                                 // Buffer interrupts are enabled during transactions
+  I2C->CR1 = I2C_CR1_PE;
+  I2C->CR2 = I2C_CR2_ACK;                                                       // ACK can be set only after the peripheral is enabled
+}
+
+/**
+@brief Register map back buffer getter
+@details Back buffer may be latched by the read transaction started before the previous swap, it 
+can not be filled until the transaction is finished.
+@return Pointer to the back buffer to be filled, 0 if the back buffer is read by the master now
+*/
+uint8_t *i2c_map_back(){
+  uint8_t back = i2c_front ^ 1;
+  return (i2c_bank == back) ? 0 : i2c_map[back];
+}
+
+/**
+@brief Register map buffers swapping
+@details Publishes the filled back buffer, it is read by the next read transactions.
+@note This function should be called only after the successful i2c_map_back() call
+*/
+void i2c_map_swap(){
+  i2c_front ^= 1;                                                               // 8-bit write is atomic
+}
+
+/**
+@brief Collected write transaction check
+@return 1 if the write transaction is passed to the main cycle and is not taken yet, 0 otherwise
+*/
+uint8_t i2c_write_pending(){
+  return i2c_write_ready;
+}
+
+/**
+@brief Collected write transaction getter
+@param[out] address Pointer to the first written register destination
+@param[out] data Pointer to the written data destination (HAL_I2C_WRITE_SIZE bytes)
+@return Written data length, 0 if there is no new write transaction
+*/
+uint8_t i2c_write_get(uint8_t *address, uint8_t *data){
+  uint8_t length;
+  if(!i2c_write_ready) return 0;
+  *address = i2c_write_address;
+  length = i2c_write_length;
+  for(uint8_t i = 0; i < length; ++i){
+    data[i] = i2c_write_data[i];
+  }
+  i2c_write_ready = 0;                                                          // Interrupt handler may collect the next transaction
+  return length;
+}
+
+/**
+@brief I2C bus state check
+@details The bus is busy between the start and the stop conditions, the CPU must not be halted 
+during the transaction addressed to the lamp.
+@return 1 if the bus is busy, 0 otherwise
+*/
+uint8_t i2c_is_busy(){
+  return (I2C->SR3 & I2C_SR3_BUSY) ? 1 : 0;
+}
+
+/**
+@brief I2C interrupt handler
+@details Handles address match, data and stop events and bus errors of the slave transactions. 
+Read transaction is finished by the master not acknowledge, write transaction is passed to the 
+main cycle by the stop condition, the main cycle is woken to handle it. Wake-up from the 
+active-halt mode by the address match is not an error: the flag is cleared and the address 
+event is handled as usual.
+*/
+INTERRUPT_HANDLER(i2c_irq_handler, HAL_I2C_IRQ){
+  uint8_t status = I2C->SR1;
+  uint8_t errors = I2C->SR2;
+  if(errors & I2C_SR2_WUFH){                                                    // Address match woke the MCU from the active-halt mode
+    I2C->SR2 = (uint8_t) ~I2C_SR2_WUFH;                                         // Flags are cleared by writing 0
+    awu_rx_wakeup = 1;
+  }
+  if(errors & (I2C_SR2_AF | I2C_SR2_BERR | I2C_SR2_ARLO | I2C_SR2_OVR)){        // Acknowledge failure (the end of reading) or bus error
+    I2C->SR2 = 0;
+    I2C->ITR &= (uint8_t) ~I2C_ITR_ITBUFEN;
+    i2c_bank = HAL_I2C_IDLE;
+    return;
+  }
+  if(status & I2C_SR1_ADDR){
+    if(I2C->SR3 & I2C_SR3_TRA){                                                 // SR1 and SR3 reading sequence clears ADDR flag
+      i2c_bank = i2c_front;                                                     // The whole transaction reads one snapshot
+    }else{
+      i2c_received = 0;
+      i2c_collect = !i2c_write_ready;
+      if(i2c_collect) i2c_write_length = 0;
+    }
+    I2C->ITR |= I2C_ITR_ITBUFEN;
+    awu_rx_wakeup = 1;                                                          // Active-halt mode must not be continued during the transaction
+  }
+  if(status & I2C_SR1_RXNE){
+    uint8_t data = I2C->DR;
+    if(!i2c_received){                                                          // The first byte is the register pointer
+      i2c_received = 1;
+      i2c_pointer = (data < HAL_I2C_MAP_SIZE) ? data : 0;
+      if(i2c_collect) i2c_write_address = i2c_pointer;
+    }else{
+      if(i2c_collect && (i2c_write_length < HAL_I2C_WRITE_SIZE)){
+        i2c_write_data[i2c_write_length++] = data;
+      }
+      if(++i2c_pointer >= HAL_I2C_MAP_SIZE) i2c_pointer = 0;
+    }
+  }
+  if((status & I2C_SR1_TXE) && (i2c_bank != HAL_I2C_IDLE)){
+    I2C->DR = i2c_map[i2c_bank][i2c_pointer];
+    if(++i2c_pointer >= HAL_I2C_MAP_SIZE) i2c_pointer = 0;
+  }
+  if(status & I2C_SR1_STOPF){
+    I2C->CR2 = I2C_CR2_ACK;                                                     // SR1 reading and CR2 writing sequence clears STOPF flag
+    I2C->ITR &= (uint8_t) ~I2C_ITR_ITBUFEN;
+    i2c_bank = HAL_I2C_IDLE;
+    if(i2c_collect && i2c_write_length){
+      i2c_collect = 0;
+      i2c_write_ready = 1;
+      CFG->GCR &= (uint8_t) ~CFG_GCR_AL;                                        // Wake the main cycle
+    }
+  }
+}
+
+///@}
+
+/**
+@addtogroup hal_spi
+@{
+*/
+
+static const uint8_t spi_codes[16][2] = {
+  {0x88, 0x88}, {0x88, 0x8E}, {0x88, 0xE8}, {0x88, 0xEE},
+  {0x8E, 0x88}, {0x8E, 0x8E}, {0x8E, 0xE8}, {0x8E, 0xEE},
+  {0xE8, 0x88}, {0xE8, 0x8E}, {0xE8, 0xE8}, {0xE8, 0xEE},
+  {0xEE, 0x88}, {0xEE, 0x8E}, {0xEE, 0xE8}, {0xEE, 0xEE}
+};                                                                              ///< SPI bytes of every data nibble, MSB first
+
+/**
+@brief SPI initialization
+@details Clocks SPI and initializes it as transmit-only master, 4MHz, MSB first. MOSI idle level 
+is low.
+*/
+void spi_init(){
+  CLK->PCKENR1 |= CLK_PCKENR1_SPI;
+  GPIOC->DDR |= HAL_SPI_MOSI_PIN | HAL_SPI_SCK_PIN;                             // Output pins are outputs
+  GPIOC->CR1 |= HAL_SPI_MOSI_PIN | HAL_SPI_SCK_PIN;                             // Push-pull
+  GPIOC->CR2 |= HAL_SPI_MOSI_PIN | HAL_SPI_SCK_PIN;                             // High-speed
+  SPI->CR2 = SPI_CR2_BDM | SPI_CR2_BDOE | SPI_CR2_SSM | SPI_CR2_SSI;            // Transmit-only, software slave management
+  SPI->CR1 = SPI_CR1_MSTR | HAL_SPI_BAUDRATE;
+  SPI->CR1 |= SPI_CR1_SPE;                                                      // SPI must be enabled after its configuration
+}
+
+/**
+@brief Pixels data sending
+@details Encodes pixels data by the lookup table and sends it. Function returns when the last bit 
+is shifted out.
+@param[in] data Pointer to the pixels data in the LEDs order (GRB for WS2812)
+@param[in] length Data length, bytes
+*/
+void spi_send_pixels(const uint8_t *data, uint16_t length){
+  while(length--){
+    const uint8_t *high = spi_codes[*data >> 4];
+    const uint8_t *low = spi_codes[*data++ & 0x0F];
+    while(!(SPI->SR & SPI_SR_TXE));
+    SPI->DR = high[0];
+    while(!(SPI->SR & SPI_SR_TXE));
+    SPI->DR = high[1];
+    while(!(SPI->SR & SPI_SR_TXE));
+    SPI->DR = low[0];
+    while(!(SPI->SR & SPI_SR_TXE));
+    SPI->DR = low[1];
+  }
+  while(!(SPI->SR & SPI_SR_TXE));
+  while(SPI->SR & SPI_SR_BSY);
+}
+
+///@}
+
 /**
 @addtogroup hal_eeprom
 @{
@@ -119,13 +964,13 @@ relative to the beginning of the EEPROM memory. If memory cells contained random
 number generator initialization value, became damaged (can not be written correctly), 
 random number generator initialization value will be written to the next memory 
 cells. After that first 2 bytes of EEPROM will contain new addres of number generator 
-initialization value relative to the beginning of the EEPROM memory.
+initialization value relative to the beginning of the EEPROM memory. The last 
+HAL_EEPROM_CONFIG_SIZE bytes of EEPROM are reserved for the configuration block.
 */
 void eeprom_init(){
-  FLASH->DUKR = HAL_EEPROM_UNBLOCK_CODE_1;                                      // Unlock EEPROM memory write protect
-  FLASH->DUKR = HAL_EEPROM_UNBLOCK_CODE_2;
+  eeprom_unlock();                                                              // Unlock EEPROM memory write protect
   if(((HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) + HAL_EEPROM_START_ADDRESS)\
-    >= HAL_EEPROM_END_ADDRESS) || ((HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) +\
+    >= HAL_EEPROM_XORSHIFT_END_ADDRESS) || ((HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) +\
       HAL_EEPROM_START_ADDRESS) < (HAL_EEPROM_START_ADDRESS + 2))){             // If random number generator initialization value address is out of EEPROM memory range
     HAL_EEPROM_WRITE_WORD(HAL_EEPROM_START_ADDRESS, 0x0002);                    // change addres to the first EEPROM memory cell after contained addres ones
   }else if((HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) +\
@@ -134,6 +979,14 @@ void eeprom_init(){
   }
 }
 
+/**
+@brief EEPROM memory write protect unlocking
+*/
+void eeprom_unlock(){
+  FLASH->DUKR = HAL_EEPROM_UNBLOCK_CODE_1;
+  FLASH->DUKR = HAL_EEPROM_UNBLOCK_CODE_2;
+}
+
 /**
 @brief Extracts random number generator initialization value from EEPROM memory
 @return Random number generator initialization value
@@ -151,8 +1004,8 @@ void save_xorshift_value(uint16_t value){
     HAL_EEPROM_START_ADDRESS, value);
   if(HAL_EEPROM_READ_WORD(HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) +\
     HAL_EEPROM_START_ADDRESS) != value){                                        // If value wasn't saved correctly (EEPROM cells are damaged)
-    if((HAL_EEPROM_READ_WORD(HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) +\
-      HAL_EEPROM_START_ADDRESS)) < (HAL_EEPROM_END_ADDRESS - 1)){               // calculate next random number generator initialization value address, save it
+    if((HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) + HAL_EEPROM_START_ADDRESS)\
+      < (HAL_EEPROM_XORSHIFT_END_ADDRESS - 2)){                                 // calculate next random number generator initialization value address (it must not reach configuration block), save it
       HAL_EEPROM_WRITE_WORD(HAL_EEPROM_START_ADDRESS,\
         HAL_EEPROM_READ_WORD(HAL_EEPROM_START_ADDRESS) + 2);
     }else{
@@ -163,6 +1016,35 @@ void save_xorshift_value(uint16_t value){
   }
 }
 
+/**
+@brief EEPROM data block reading
+@param[in] address EEPROM memory address
+@param[out] data Destination pointer
+@param[in] length Data length, bytes
+*/
+void eeprom_read(uint16_t address, uint8_t *data, uint8_t length){
+  while(length--){
+    *data++ = HAL_EEPROM_READ_BYTE(address++);
+  }
+}
+
+/**
+@brief EEPROM data block writing
+@details Writes only bytes which differ from the EEPROM memory content, so unchanged data does not 
+wear EEPROM cells and does not take writing time.
+@param[in] address EEPROM memory address
+@param[in] data Source pointer
+@param[in] length Data length, bytes
+@note EEPROM memory must be unlocked
+*/
+void eeprom_write(uint16_t address, const uint8_t *data, uint8_t length){
+  while(length--){
+    if(HAL_EEPROM_READ_BYTE(address) != *data) HAL_EEPROM_WRITE_BYTE(address, *data);
+    ++address;
+    ++data;
+  }
+}
+
 /**
 @brief EEPROM memory deinitialization
 @details Blocks EEPROM memory for write protection
@@ -40,8 +40,6 @@
 @{
 */
 
-#define HAL_GPIO_PINS_MASK                      0x1C
-
 void gpio_init();
 
 ///@}
@@ -50,12 +48,29 @@ void gpio_init();
 @defgroup hal_clk HAL CLK
 @ingroup hal
 @brief Consists MCU clocking control functions
+@details Only used peripherals are clocked. Peripherals are clocked by Fmaster, so CPU clock 
+divider does not change PWM frequency, tick period and UART baud rate.
+
+All timings (tick period, UART baud rate) are derived from HSI. Its accuracy is about 1% at 25C 
+after the factory trimming and a few percent over the whole temperature range (see the MCU 
+datasheet). HSI of the particular unit can be corrected by the user trimming value (one step of 
+HSI trimmer is a fraction of percent), it is stored in the runtime configuration.
 @{
 */
 
 #define HAL_CLK_HSI_DIV_1_OUTPUT                0x00
+#define HAL_CLK_CPU_SLOW_DIV                    0x03                            ///< Slow CPU clock divider: Fcpu = Fmaster / 8
+#define HAL_CLK_PCKENR1                         (CLK_PCKENR1_TIM1 | CLK_PCKENR1_TIM4 | CLK_PCKENR1_UART2 |\
+                                                 CLK_PCKENR1_I2C |\
+                                                 ((HAL_PWM_CHANNELS_NUMBER > 4) ? CLK_PCKENR1_TIM2 : 0) |\
+                                                 ((HAL_PWM_CHANNELS_NUMBER > 7) ? CLK_PCKENR1_TIM3 : 0)) ///< Clocked peripherals: PWM timers, tick timer, UART2, I2C
+#define HAL_CLK_PCKENR2                         CLK_PCKENR2_AWU                 ///< Clocked peripherals: AWU (ADC and CAN are gated)
+#define HAL_CLK_TRIM_MIN                        (-4)                            ///< Minimal HSI user trimming value
+#define HAL_CLK_TRIM_MAX                        3                               ///< Maximal HSI user trimming value
 
 void clk_init();
+void clk_cpu_slow(uint8_t slow);
+void clk_trim(int8_t trim);
 
 ///@}
 
@@ -66,8 +81,245 @@ void clk_init();
 @{
 */
 
+/**
+@brief PWM logical channels
+@details Logical channels are mapped onto 16-bit timers compare outputs:
+@code
+channel  0        1        2        3        4        5        6        7        8
+output   TIM1_CH4 TIM1_CH3 TIM1_CH2 TIM1_CH1 TIM2_CH1 TIM2_CH2 TIM2_CH3 TIM3_CH1 TIM3_CH2
+pin      PC4      PC3      PC2      PC1      PD4      PD3      PA3      PD2      PD0
+@endcode
+Channels 0, 1 and 2 are the board R, G and B outputs, channel 3 is the board white (W) output. 
+Only the first HAL_PWM_CHANNELS_NUMBER channels are initialized and driven. Mood lamp logic 
+instances (zones) take 3 consecutive channels each: the first instance takes channels 0...2 (and 
+channel 3 if the white output is enabled in output.h), the next instances take the following 
+channels, so up to 3 RGB zones or one RGBW and one RGB zone can be driven.
+
+Batch update execution time is measured in the PWM_UPDATE profiler slot, it can be read on the 
+simulator or on the board by tools/benchmark.py (build with HAL_PWM_CHANNELS_NUMBER of 9 for the 
+worst case).
+*/
+#define HAL_PWM_CHANNELS_MAX                    9                               ///< Available PWM channels quantity
+#define HAL_PWM_CHANNELS_NUMBER                 3                               ///< Used PWM channels quantity (1...HAL_PWM_CHANNELS_MAX)
+#define HAL_PWM_WHITE_CHANNEL                   3                               ///< Board white output channel
+#define HAL_PWM_NO_CHANNEL                      0xFF                            ///< Absent channel number
+#define HAL_PWM_MODE                            0x68                            ///< Compare mode register value: PWM mode 1, preload register is on
+#define HAL_PWM_FORCE_LOW                       0x48                            ///< Compare mode register value: output is forced low
+#define HAL_PWM_FORCE_HIGH                      0x58                            ///< Compare mode register value: output is forced high
+#define HAL_PWM_STATIC_MARGIN                   64                              ///< Levels this close to U16_MAX are treated as fully turned on by static outputs
+
 void pwm_init();
 void set_rgbw_output_value(uint8_t channel, uint16_t value);
+void pwm_update();
+uint16_t get_cycles_counter();
+uint8_t pwm_is_static();
+void pwm_force_static(uint8_t force);
+
+///@}
+
+/**
+@defgroup hal_uart HAL UART
+@ingroup hal
+@brief Consists serial port control functions
+@{
+*/
+
+#define HAL_UART_BAUDRATE_DIVIDER               ((uint16_t) 139)                ///< UART2 baud rate divider: 16MHz / 139 ~ 115200 baud
+#define HAL_UART_TX_BUFFER_SIZE                 64                              ///< Transmitter ring buffer size, must be a power of two
+#define HAL_UART_RX_BUFFER_SIZE                 32                              ///< Receiver ring buffer size, must be a power of two
+#define HAL_UART_TX_IRQ                         20                              ///< UART2 transmitter interrupt vector number
+#define HAL_UART_RX_IRQ                         21                              ///< UART2 receiver interrupt vector number
+
+void uart_init();
+uint8_t uart_write(const uint8_t *data, uint8_t length);
+uint8_t uart_read(uint8_t *data);
+uint8_t uart_rx_pending();
+uint8_t uart_tx_idle();
+
+///@}
+
+/**
+@defgroup hal_dmx HAL DMX512
+@ingroup hal
+@brief Consists DMX512 receiver functions
+@details If DMX512 start address is set, UART2 receiver interrupt handler detects DMX512 break 
+(received zero byte with framing error: line is low longer than the byte time). Break received 
+in the command mode (115200 baud) switches UART2 to 250000 baud 8N2 at once. A zero byte with 
+framing error can also be a damaged command byte, so the signal is qualified first: the frame 
+after the break must have the null start code and reach the last used slot without errors, and 
+only the frames after it are latched. Damaged byte or alternate start code before the 
+qualification returns UART2 to the command mode at once. Frames are parsed byte by byte by the 
+receiver interrupt handler: only null start code frames are used, HAL_DMX_SLOTS slots beginning 
+from the start address are collected and latched into the PWM channels shadow values (with 
+quadratic apparent brightness linearization) when the last of them is received, so the main 
+cycle only writes latched values into timers. Frame with overrun or framing error is dropped 
+until the next break. Break detection and frames parsing are checked on the host by 
+tools/host/dmx_check.c.
+
+Receiver interrupt handler cycle budget at Fcpu = 16MHz is estimated from the source, it was not 
+measured: one slot takes 11 bits * 4us = 44us (704 cycles). The receiver has the data register 
+and the shift register, so a byte is lost only if the handler does not read the data register 
+during the next slot time. The handler is estimated at about 40 cycles for an ordinary slot and 
+about 40 cycles plus 20 cycles per channel for the latching slot, interrupt entry and return take 
+about 20 cycles, the longest other handler (tick timer) about 60 cycles. So the worst-case 
+response (under 250 cycles even with 9 channels) should leave more than 450 cycles of margin at 
+the full 512-slot frame rate (44 frames per second). Received frames and dropped frames are 
+counted for telemetry, so overruns can be checked on the board or in the simulator.
+@{
+*/
+
+#define HAL_DMX_BAUDRATE_DIVIDER                ((uint16_t) 64)                 ///< UART2 baud rate divider in DMX512 mode: 16MHz / 64 = 250000 baud
+#define HAL_DMX_STOP_BITS                       0x20                            ///< UART2 CR3 value in DMX512 mode: 2 stop bits
+#define HAL_DMX_SLOTS                           HAL_PWM_CHANNELS_NUMBER         ///< Used slots quantity, one slot per PWM channel
+#define HAL_DMX_UNIVERSE_SIZE                   512                             ///< DMX512 slots quantity
+#define HAL_DMX_IDLE                            0xFFFF                          ///< Receiver waits for break
+
+void dmx_set_address(uint16_t address);
+uint8_t dmx_is_active();
+void dmx_stop();
+uint16_t get_dmx_frames();
+uint16_t get_dmx_errors();
+
+///@}
+
+/**
+@defgroup hal_tick HAL tick timer
+@ingroup hal
+@brief Consists main cycle tick timer control functions
+@details TIM4 counts ticks of HAL_TICK_COUNTS timer counts. While the main cycle sleeps for 
+several ticks, one timer period covers up to HAL_TICK_CHUNK_MAX ticks, and the CPU returns to the 
+wait mode after the timer interrupt (interrupt-only activation level) until the whole sleep time 
+is elapsed, so it is woken as rarely as possible. Received UART byte wakes the main cycle 
+immediately. Timer runs only in the timer scheduler modes (see tick_run()), so it does not wake 
+the CPU in the loop mode.
+@{
+*/
+
+#define HAL_TICK_PRESCALER                      7                               ///< TIM4 prescaler: 16MHz / 2^7 = 125kHz
+#define HAL_TICK_COUNTS                         16                              ///< TIM4 counts per tick: tick period is 128us
+#define HAL_TICK_CHUNK_MAX                      16                              ///< Maximal ticks per TIM4 period (8-bit counter)
+#define HAL_TICK_IRQ                            23                              ///< TIM4 update interrupt vector number
+
+void tick_init();
+void tick_run(uint8_t run);
+uint16_t tick_wait(uint16_t ticks);
+uint16_t get_tick_interrupts();
+
+///@}
+
+/**
+@defgroup hal_awu HAL auto-wakeup
+@ingroup hal
+@brief Consists active-halt mode control functions
+@details In the active-halt mode the main clock is stopped, so PWM timers are stopped too and their 
+outputs keep the levels they had at the moment of halt. Therefore the active-halt mode can be used 
+only when all PWM outputs are static (see pwm_is_static() and pwm_force_static()). The CPU is 
+woken by the auto-wakeup unit (AWU, clocked by LSI) every HAL_AWU_TICKS ticks. Main voltage 
+regulator and flash memory are powered down during the active-halt mode.
+
+LSI accuracy is poor (up to 12.5%), so its frequency is measured against HSI at initialization 
+(LSI is connected to TIM3 input capture 1) and the AWU period is counted in measured 1/256 ticks. 
+Therefore ticks elapsed in the active-halt mode have the HSI accuracy.
+
+UART is stopped too, so the byte received during the active-halt mode is lost: its start bit wakes 
+the CPU by RX pin external interrupt. Host should send any wake-up byte (for example 0x00, it is 
+skipped by the frame synchronization) before commands. The scheduler does not halt again for a 
+while after such a wakeup (see @ref scheduler), so the following bytes are received.
+
+The tick timer is stopped in the active-halt mode and the AWU counter can not be read, so the 
+elapsed part of the AWU period interrupted by incoming data is not known. It is credited by its 
+expected value (half of the period), so the error of such wakeup is within a half of the AWU 
+period and the interruptions do not drift the color flow time on average.
+@{
+*/
+
+#define HAL_AWU_APR                             30                              ///< AWU asynchronous prescaler: APRDIV = 32
+#define HAL_AWU_TBR                             7                               ///< AWU time base: 2^6 * APRDIV LSI periods
+#define HAL_AWU_TICKS                           125                             ///< Nominal AWU period, ticks: 2048 / 128kHz = 16ms
+#define HAL_AWU_TICKS_MIN                       100                             ///< Minimal measured AWU period, ticks (LSI is +25% fast)
+#define HAL_AWU_TICKS_MAX                       160                             ///< Maximal measured AWU period, ticks (LSI is 22% slow)
+#define HAL_AWU_MEASURE_CCMR                    0x0D                            ///< TIM3 capture 1 mode: TI1 input, capture every 8 LSI periods
+#define HAL_AWU_MEASURE_CAPTURES                4                               ///< Captures per LSI measurement (32 LSI periods)
+#define HAL_AWU_MEASURE_TIMEOUT                 0xFFFF                          ///< LSI capture waiting iterations limit
+#define HAL_AWU_RX_PIN                          0x40                            ///< UART RX pin (PD6) mask
+#define HAL_AWU_RX_SENSITIVITY                  0x80                            ///< Port D external interrupt on falling edge only
+#define HAL_AWU_IRQ                             1                               ///< AWU interrupt vector number
+#define HAL_AWU_RX_IRQ                          6                               ///< Port D external interrupt vector number
+
+void awu_init();
+uint16_t awu_halt(uint16_t ticks);
+uint8_t awu_is_interrupted();
+
+///@}
+
+/**
+@defgroup hal_i2c HAL I2C
+@ingroup hal
+@brief Consists I2C slave functions
+@details I2C is a slave with HAL_I2C_ADDRESS 7-bit address (SCL pin is PB4, SDA pin is PB5), it 
+exposes HAL_I2C_MAP_SIZE bytes register map. Transactions are handled by the interrupt handler 
+only, the main cycle never waits for the bus:
+- write transaction: the first byte sets the register pointer, the next bytes (no more than 
+HAL_I2C_WRITE_SIZE) are collected and passed to the main cycle after the stop condition (see 
+i2c_write_get()). Data of the next write transaction is dropped until the main cycle takes the 
+previous one;
+- read transaction: bytes are read from the register pointer, the pointer is incremented after 
+every byte and wraps around at the end of the map.
+
+Register map is double-buffered: the main cycle fills the back buffer (see i2c_map_back()) and 
+publishes it by swapping buffers (see i2c_map_swap()), the interrupt handler latches the front 
+buffer at the address match, so the whole read transaction gets one snapshot and multibyte values 
+are never torn. Address match wakes the CPU from the active-halt mode.
+@{
+*/
+
+#define HAL_I2C_ADDRESS                         0x4D                            ///< I2C slave 7-bit address
+#define HAL_I2C_FREQR                           16                              ///< Peripheral clock frequency, MHz
+#define HAL_I2C_MAP_SIZE                        48                              ///< Register map size, bytes
+#define HAL_I2C_WRITE_SIZE                      20                              ///< Maximal data length of the write transaction, bytes
+#define HAL_I2C_IRQ                             19                              ///< I2C interrupt vector number
+#define HAL_I2C_IDLE                            0xFF                            ///< No read transaction is in progress
+
+void i2c_init();
+uint8_t *i2c_map_back();
+void i2c_map_swap();
+uint8_t i2c_write_pending();
+uint8_t i2c_write_get(uint8_t *address, uint8_t *data);
+uint8_t i2c_is_busy();
+
+///@}
+
+/**
+@defgroup hal_spi HAL SPI
+@ingroup hal
+@brief Consists addressable LED strip output functions
+@details WS2812-class LEDs (WS2812B, SK6812) are driven by SPI MOSI pin (PC6) at 4MHz: every LED 
+data bit is encoded by 4 SPI bits (1 - 1110, 0 - 1000, so the bit is 1us long with 750ns or 250ns 
+high level), every nibble of the pixel data is encoded by 2 SPI bytes taken from the lookup table. 
+The last SPI bit of every byte is 0, so gaps between SPI bytes (interrupt handlers) only stretch 
+the low level of the LED bit, which is tolerated by the LEDs up to their reset time.
+
+STM8S105 has no DMA, so the data is sent by the polled loop, which blocks the caller for the whole 
+frame: the next byte is taken from the lookup table while the previous one is shifted out (SPI has 
+the data register and the shift register). Frame throughput at Fmaster = 16MHz: 12 SPI bytes per 
+pixel, 2us (32 CPU cycles) each, so 24us per pixel or 41666 pixels per second. The loop is 
+estimated from the source at about 15 CPU cycles per byte (it was not measured), so it should be 
+limited by the wire speed. For example, 30 pixels frame takes 0.72ms, 60 pixels frame takes 
+1.44ms. Sending from the SPI interrupt would not free the CPU: the interrupt entry and return alone 
+take most of the 32 cycles of a byte. Frames must be separated by the LEDs reset time 
+(HAL_SPI_RESET_US), it is the caller duty.
+@{
+*/
+
+#define HAL_SPI_BAUDRATE                        0x08                            ///< SPI CR1 baud rate bits: Fmaster / 4 = 4MHz
+#define HAL_SPI_MOSI_PIN                        0x40                            ///< MOSI pin (PC6)
+#define HAL_SPI_SCK_PIN                         0x20                            ///< SCK pin (PC5), it is not used by LEDs
+#define HAL_SPI_BYTES_PER_PIXEL                 12                              ///< SPI bytes per 3-byte pixel
+#define HAL_SPI_PIXEL_CYCLES                    (HAL_SPI_BYTES_PER_PIXEL * 32)  ///< Pixel wire time, CPU cycles at Fcpu = 16MHz
+#define HAL_SPI_RESET_US                        80                              ///< LEDs reset (latch) time, us (SK6812 needs 80us, WS2812B needs 50us)
+
+void spi_init();
+void spi_send_pixels(const uint8_t *data, uint16_t length);
 
 ///@}
 
@@ -83,14 +335,20 @@ void set_rgbw_output_value(uint8_t channel, uint16_t value);
 #define HAL_EEPROM_BLOCK_CODE                   ((uint8_t) 0x08)
 #define HAL_EEPROM_START_ADDRESS                ((uint16_t) 0x4000)
 #define HAL_EEPROM_END_ADDRESS                  ((uint16_t) 0x427F)
+#define HAL_EEPROM_CONFIG_SIZE                  ((uint16_t) 64)                 ///< Configuration block area size, bytes
+#define HAL_EEPROM_CONFIG_ADDRESS               ((uint16_t) (HAL_EEPROM_END_ADDRESS + 1 - HAL_EEPROM_CONFIG_SIZE)) ///< Configuration block area is at the end of EEPROM
+#define HAL_EEPROM_XORSHIFT_END_ADDRESS         ((uint16_t) (HAL_EEPROM_CONFIG_ADDRESS - 1)) ///< Random number generator initialization value area end
 #define HAL_EEPROM_READ_BYTE(ADDRESS)           (*(PointerAttr uint8_t *) ((MemoryAddressCast) (ADDRESS)))
 #define HAL_EEPROM_WRITE_BYTE(ADDRESS,DATA)     do{*(PointerAttr uint8_t*) ((MemoryAddressCast) (ADDRESS)) = (uint8_t)(DATA);}while(0)
 #define HAL_EEPROM_READ_WORD(ADDRESS)           ((((uint16_t) HAL_EEPROM_READ_BYTE(ADDRESS)) << 8) + HAL_EEPROM_READ_BYTE((ADDRESS) + 1))
 #define HAL_EEPROM_WRITE_WORD(ADDRESS,DATA)     do{HAL_EEPROM_WRITE_BYTE((ADDRESS), (DATA) >> 8);HAL_EEPROM_WRITE_BYTE((ADDRESS) + 1, (DATA));}while(0)
 
 void eeprom_init();
+void eeprom_unlock();
 uint16_t get_saved_xorshift_value();
 void save_xorshift_value(uint16_t value);
+void eeprom_read(uint16_t address, uint8_t *data, uint8_t length);
+void eeprom_write(uint16_t address, const uint8_t *data, uint8_t length);
 void eeprom_deinit();
 
 ///@}
@@ -25,13 +25,25 @@
 /**
 @mainpage This firmware realizes mood lamp logic on <a href="https://github.com/AntaresLab/RGBW_controller">AntaresLab RGBW controller board</a>.
 
-There are only R, G and B board outputs used for this functional.
+R, G and B board outputs are used for this functional, W output is used optionally (for RGBW strips).
 
 Board power-off detector is not used in this firmware.
 
 On-board MCU is STM8S105K4.
 
-Color outputs are: PC4 (R), PC3 (G), PC2 (B).
+Color outputs are: PC4 (R), PC3 (G), PC2 (B) and PC1 (W, if white output is enabled in output.h). 
+Additional zones outputs are described in @ref hal_pwm.
+
+Telemetry output is UART2 TX: PD5 (115200 baud, 8N1). Frame format is described in protocol.h and 
+telemetry.h, frames can be decoded on the host by tools/telemetry_decode.py.
+
+Control commands input is UART2 RX: PD6 (115200 baud, 8N1). Commands are described in protocol.h. 
+If DMX512 start address is set, DMX512 frames (250000 baud, 8N2) are received on the same pin 
+(see dmx.h).
+
+Host MCU control interface is I2C slave: PB4 (SCL), PB5 (SDA). Register map is described in regmap.h.
+
+Addressable LED strip output (if it is enabled in strip.h) is SPI MOSI: PC6 (WS2812-class LEDs).
 
 Another MCU pins are unused.
 
@@ -43,6 +55,20 @@ Optimization level: low.
 #include "hal.h"
 #include "mood_logic.h"
 #include "xorshift.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "command.h"
+#include "config.h"
+#include "output.h"
+#include "scheduler.h"
+#include "sync.h"
+#include "dmx.h"
+#include "regmap.h"
+#include "strip.h"
+
+#if 3 * MOOD_ENGINES_NUMBER + OUTPUT_WHITE_ENABLE > HAL_PWM_CHANNELS_NUMBER
+ #error "Not enough PWM channels for all mood lamp logic instances"
+#endif
 
 /**
 @defgroup main Main module
@@ -56,14 +82,58 @@ Optimization level: low.
 void main(){
   gpio_init();                                                                  // GPIO initialization
   clk_init();                                                                   // 16MHz HSI initialization
-  pwm_init();                                                                   // PWM timer initialization
   eeprom_init();                                                                // EEPROM memory initialization
+  config_load();                                                                // Runtime configuration loading
+  clk_trim(mood_config.hsi_trim);                                               // HSI user trimming
+  awu_init();                                                                   // LSI measurement and active-halt mode wakeup initialization
+  pwm_init();                                                                   // PWM timer initialization
+  output_init();                                                                // Output stage initialization
+  strip_init();                                                                 // Addressable strip output initialization
   uint16_xorshift_init(get_saved_xorshift_value());                             // Xorshift random generator initialization
   save_xorshift_value(get_random_uint16());                                     // Xorshift random generator new state saving (for next power-on)
   eeprom_deinit();                                                              // EEPROM deinitialization for EEPROM data corrupting possibility exclision
+  sync_init();                                                                  // Mood lamp logic instances seed for synchronization
+  dmx_init();                                                                   // DMX512 start address setting
+  for(uint8_t i = 0, channel = 0; i < MOOD_ENGINES_NUMBER; ++i){                // Mood lamp logic instances initialization
+    if(OUTPUT_WHITE_ENABLE && !i){                                              // The first instance drives the board W output
+      mood_engine_init(&mood_engines[i], channel, HAL_PWM_WHITE_CHANNEL);
+      channel += 4;
+    }else{
+      mood_engine_init(&mood_engines[i], channel, HAL_PWM_NO_CHANNEL);
+      channel += 3;
+    }
+  }
+  uart_init();                                                                  // Telemetry and commands UART initialization
+  i2c_init();                                                                   // Register map I2C slave initialization
+  tick_init();                                                                  // Tick timer initialization
+  enableInterrupts();
   while(1){                                                                     // Main cycle
-    rgb_handle();                                                               // Mood lamp logic handling
-    for(uint16_t i = 0; i < 200; ++i);                                          // Color flow speed regulation
+    uint16_t timestamp;
+    uint16_t steps;
+    uint16_t ticks = scheduler_wait();                                          // Waiting for the next tick (or the next output change)
+    profiler_tick();                                                            // Tick period measurement
+    command_handle();                                                           // Received commands handling
+    steps = sync_handle(scheduler_steps(ticks));                                // Color flow steps, multi-lamp synchronization
+    if(!dmx_handle(ticks)){                                                     // PWM levels are not set by DMX512 frames
+      timestamp = profiler_start();
+      if(steps) rgb_advance(steps - 1);                                         // Slept or faster than tick steps, choices are made on time
+      for(uint8_t i = 0; steps && (i < MOOD_ENGINES_NUMBER); ++i){              // Mood lamp logic handling
+        rgb_handle(&mood_engines[i]);
+      }
+      profiler_stop(PROFILER_SLOT_RGB_HANDLE, timestamp);
+      timestamp = profiler_start();
+      for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){                         // Colors to PWM levels conversion
+        output_handle(&mood_engines[i]);
+      }
+      output_update();                                                          // Power limitation
+      profiler_stop(PROFILER_SLOT_OUTPUT, timestamp);
+    }
+    timestamp = profiler_start();
+    pwm_update();                                                               // All zones PWM levels updating
+    profiler_stop(PROFILER_SLOT_PWM_UPDATE, timestamp);
+    strip_handle(ticks, steps);                                                 // Addressable strip frame rendering and sending
+    telemetry_handle(ticks);                                                    // Lamp state reporting
+    regmap_handle(ticks);                                                       // I2C register map writes applying and registers publishing
   }
 }
 
@@ -24,76 +24,642 @@
 
 #include "mood_logic.h"
 #include "xorshift.h"
-#include "hal.h"
+#include "config.h"
+#include "color.h"
+#include "palette.h"
 
 /**
 @addtogroup mood_lamp_logic
 @{
 */
 
-static uint16_t destination_color[] = {0, 0, 0};                                ///< Color channels destination PWM values {R, G, B}
-static uint16_t current_color[] = {0, 0, 0};                                    ///< Color channels current PWM values {R, G, B}
+mood_engine_t mood_engines[MOOD_ENGINES_NUMBER];                                ///< Mood lamp logic instances
+
+/**
+@brief Word interpolation
+@param[in] from Start value
+@param[in] to Destination value
+@param[in] fraction Passed part of the way (0...U16_MAX)
+@return Interpolated value
+*/
+static uint16_t interpolate(uint16_t from, uint16_t to, uint16_t fraction){
+  if(to >= from) return from + (uint16_t) ((((uint32_t) (to - from)) * fraction) >> 16);
+  return from - (uint16_t) ((((uint32_t) (from - to)) * fraction) >> 16);
+}
+
+/**
+@brief Signed fixed-point multiplication
+@param[in] a Signed multiplicand (no more than 2^20 by absolute value)
+@param[in] t Fraction (0...U16_MAX)
+@return a * t / 65536
+*/
+static int32_t multiply_fraction(int32_t a, uint16_t t){
+  uint32_t magnitude = (a < 0) ? -(uint32_t) a : (uint32_t) a;
+  uint32_t product = (magnitude >> 16) * t + ((((uint32_t) (uint16_t) magnitude) * t) >> 16);
+  return (a < 0) ? -(int32_t) product : (int32_t) product;
+}
+
+/**
+@brief Random color generation
+@details Chooses random color scheme according to the color schemes shares and random color 
+within the scheme, takes random OKLab gamut sample or the next palette color, depending on 
+sampling mode.
+@param[in] phase Palette sampling low-discrepancy sequence phase of the color
+@param[out] color Generated color {R, G, B}
+@return Color scheme of the generated color
+*/
+static uint8_t random_color(uint16_t phase, uint16_t *color){
+  uint16_t share;
+  uint8_t scheme = RGB_ONE_COLOR_SCHEME;
+  if(mood_config.sampling == RGB_SAMPLING_OKLAB){
+    get_oklab_sample((uint8_t) (get_random_uint16() >> 8), color);
+    return RGB_OKLAB_SCHEME;
+  }
+  if(mood_config.sampling == RGB_SAMPLING_PALETTE){
+    uint8_t position = (uint8_t) (phase >> 8);
+    get_palette_color(mood_config.palette, (uint8_t) ((position * (uint16_t) get_palette_size(mood_config.palette)) >> 8), color);
+    return RGB_PALETTE_SCHEME;
+  }
+  share = get_random_uint16() % mood_config.scheme_probabilities_sum;           // Choose random color scheme for new destination color
+  while(share >= mood_config.scheme_probabilities[scheme]){
+    share -= mood_config.scheme_probabilities[scheme++];
+  }
+  switch(scheme){
+  case RGB_ONE_COLOR_SCHEME:                                                    // Only one random color channel full power color scheme
+    for(uint8_t i = 0; i < 3; ++i){
+      color[i] = 0;
+    }
+    color[get_random_uint16() % 3] = U16_MAX;
+    break;
+  case RGB_TWO_COLORS_SCHEME:                                                   // Only two random color channels full power color scheme
+    for(uint8_t i = 0; i < 3; ++i){
+      color[i] = U16_MAX;
+    }
+    color[get_random_uint16() % 3] = 0;
+    break;
+  case RGB_THREE_COLORS_SCHEME:                                                 // Three (all) color channels full power color scheme
+    for(uint8_t i = 0; i < 3; ++i){
+      color[i] = U16_MAX;
+    }
+    break;
+  case RGB_ONE_COLOR_AND_RANDOM_SCHEME:                                         // One random color channel full power, another color channels - random power color scheme
+    for(uint8_t i = 0; i < 3; ++i){
+      color[i] = get_random_uint16();
+    }
+    color[get_random_uint16() % 3] = U16_MAX;
+    break;
+  default:                                                                      // One random color channel random power, another color channels - full power color scheme
+    for(uint8_t i = 0; i < 3; ++i){
+      color[i] = U16_MAX;
+    }
+    color[get_random_uint16() % 3] = get_random_uint16();
+    break;
+  }
+  return scheme;
+}
+
+/**
+@brief Random color picking
+@details Draws random colors until the color far enough from all colors of the history ring is 
+found, but no more than RGB_PICK_ATTEMPTS times. If all drawn colors are too close, the farthest 
+one is used (the farthest from the latest color if distances are equal). Picked color is added to 
+the history ring. Palette sampling phase is advanced to the picked color only, so draws rejected 
+after it do not skip palette colors.
+@param[in,out] e Mood lamp logic instance context
+@param[out] color Picked color {R, G, B}
+@return Color scheme of the picked color
+*/
+static uint8_t pick_color(mood_engine_t *e, uint16_t *color){
+  uint16_t candidate[3];
+  uint16_t lightness[3];
+  uint16_t best_lightness[3];
+  uint32_t best_distance = 0;
+  uint32_t best_latest_distance = 0;
+  uint8_t best_scheme = RGB_ONE_COLOR_SCHEME;
+  uint8_t latest = (e->history_head + RGB_HISTORY_SIZE - 1) % RGB_HISTORY_SIZE;
+  uint16_t phase = e->palette_phase;
+  uint16_t best_phase = phase;
+  for(uint8_t attempt = 0; attempt < RGB_PICK_ATTEMPTS; ++attempt){
+    uint8_t scheme;
+    phase += RGB_GOLDEN_RATIO_STEP;
+    scheme = random_color(phase, candidate);
+    uint32_t distance = U32_MAX;
+    uint32_t latest_distance = 0;
+    for(uint8_t i = 0; i < 3; ++i){
+      lightness[i] = value_to_lightness(candidate[i]);
+    }
+    for(uint8_t j = 0; j < RGB_HISTORY_SIZE; ++j){                              // Distance to the nearest recent color
+      uint32_t sum = 0;
+      for(uint8_t i = 0; i < 3; ++i){
+        sum += (lightness[i] > e->history[j][i]) ? lightness[i] - e->history[j][i] : e->history[j][i] - lightness[i];
+      }
+      if(sum < distance) distance = sum;
+      if(j == latest) latest_distance = sum;
+    }
+    if(!attempt || (distance > best_distance) ||\
+      ((distance == best_distance) && (latest_distance > best_latest_distance))){
+      best_distance = distance;
+      best_latest_distance = latest_distance;
+      best_scheme = scheme;
+      best_phase = phase;
+      for(uint8_t i = 0; i < 3; ++i){
+        color[i] = candidate[i];
+        best_lightness[i] = lightness[i];
+      }
+    }
+    if(distance >= mood_config.min_distance) break;                             // Candidate is far enough from the recent colors
+  }
+  for(uint8_t i = 0; i < 3; ++i){                                               // The oldest color is replaced by the picked one
+    e->history[e->history_head][i] = best_lightness[i];
+  }
+  e->history_head = (e->history_head + 1) % RGB_HISTORY_SIZE;
+  e->palette_phase = best_phase;
+  return best_scheme;
+}
+
+/**
+@brief Stepping transition check
+@param[in] e Mood lamp logic instance context
+@return 1 if the transition is made by independent one LSB channels steps, 0 if the transition is 
+progress-based
+*/
+static uint8_t transition_is_stepping(const mood_engine_t *e){
+  return (e->interpolation == RGB_INTERPOLATION_LINEAR) && (e->easing == EASING_LINEAR) &&\
+    (e->pacing == RGB_PACING_UNIFORM);
+}
+
+/**
+@brief Pacing conversion
+@param[in] e Mood lamp logic instance context
+@param[in] value Color channel value
+@return Interpolation coordinate: apparent lightness in lightness pacing, value itself otherwise
+*/
+static uint16_t pace(const mood_engine_t *e, uint16_t value){
+  return (e->pacing == RGB_PACING_LIGHTNESS) ? value_to_lightness(value) : value;
+}
+
+/**
+@brief Pacing inverse conversion
+@param[in] e Mood lamp logic instance context
+@param[in] coordinate Interpolation coordinate
+@return Color channel value
+*/
+static uint16_t unpace(const mood_engine_t *e, uint16_t coordinate){
+  return (e->pacing == RGB_PACING_LIGHTNESS) ? lightness_to_value(coordinate) : coordinate;
+}
+
+/**
+@brief Transition start
+@details Latches the interpolation mode, easing curve and pacing and prepares the transition from 
+the current color to the destination color. Transition time is the maximal color channel 
+difference, so all modes have the same color flow speed. Interpolation is made in the pacing 
+coordinates: channel values or their apparent lightness (HSV mode paces the value component). 
+Colors are converted and spline polynomial coefficients are calculated once here, every tick 
+interpolation makes only multiplications and table lookups.
+@param[in,out] e Mood lamp logic instance context
+*/
+static void transition_start(mood_engine_t *e){
+  uint16_t length = 0;
+  const uint16_t *next = e->lookahead_color[e->lookahead_head];
+  e->interpolation = mood_config.interpolation;
+  e->easing = (mood_config.easing == RGB_EASING_RANDOM) ? get_random_uint16() % EASINGS_NUMBER : mood_config.easing;
+  e->pacing = mood_config.pacing;
+  for(uint8_t i = 0; i < 3; ++i){
+    uint16_t difference = (e->current_color[i] > e->destination_color[i]) ?\
+      e->current_color[i] - e->destination_color[i] : e->destination_color[i] - e->current_color[i];
+    if(difference > length) length = difference;
+  }
+  e->transition_ticks = length;
+  e->progress = 0;
+  if(length && !transition_is_stepping(e)){
+    e->progress_step = U32_MAX / length;
+    if(e->interpolation == RGB_INTERPOLATION_HSV){
+      rgb_to_hsv(e->current_color, e->start_point);
+      rgb_to_hsv(e->destination_color, e->destination_point);
+      if(!e->start_point[1]){                                                   // Achromatic color has no hue, the other color hue is used
+        e->start_point[0] = e->destination_point[0];
+      }else if(!e->destination_point[1]){
+        e->destination_point[0] = e->start_point[0];
+      }
+      e->start_point[2] = pace(e, e->start_point[2]);
+      e->destination_point[2] = pace(e, e->destination_point[2]);
+    }else{
+      for(uint8_t i = 0; i < 3; ++i){
+        e->start_point[i] = pace(e, e->current_color[i]);
+        e->destination_point[i] = pace(e, e->destination_color[i]);
+      }
+    }
+    if(e->interpolation == RGB_INTERPOLATION_SPLINE){
+      for(uint8_t i = 0; i < 3; ++i){                                           // Catmull-Rom spline: P0 - previous waypoint, P1 - current color, P2 - destination, P3 - the next destination
+        int32_t p0 = pace(e, e->start_color[i]);
+        int32_t p1 = e->start_point[i];
+        int32_t p2 = e->destination_point[i];
+        int32_t p3 = pace(e, next[i]);
+        e->spline[i][0] = (p2 - p0) / 2;
+        e->spline[i][1] = (2 * p0 - 5 * p1 + 4 * p2 - p3) / 2;
+        e->spline[i][2] = (3 * (p1 - p2) + p3 - p0) / 2;
+      }
+    }
+  }
+  for(uint8_t i = 0; i < 3; ++i){                                               // The previous waypoint of the next transition
+    e->start_color[i] = e->current_color[i];
+  }
+}
+
+/**
+@brief Progress-based interpolation step
+@details Applies the easing curve to the transition progress and interpolates the color in the 
+latched mode.
+@param[in,out] e Mood lamp logic instance context
+@note The last step sets the destination color exactly, so conversion errors are not accumulated
+*/
+static void transition_step(mood_engine_t *e){
+  uint16_t hsv[3];
+  uint16_t fraction;
+  uint16_t hue_difference;
+  if(!--e->transition_ticks){                                                   // Transition is finished
+    for(uint8_t i = 0; i < 3; ++i){
+      e->current_color[i] = e->destination_color[i];
+    }
+    return;
+  }
+  e->progress += e->progress_step;
+  fraction = easing_apply(e->easing, (uint16_t) (e->progress >> 16));
+  if(e->interpolation == RGB_INTERPOLATION_LINEAR){                             // All channels simultaneously
+    for(uint8_t i = 0; i < 3; ++i){
+      e->current_color[i] = unpace(e, interpolate(e->start_point[i], e->destination_point[i], fraction));
+    }
+    return;
+  }
+  if(e->interpolation == RGB_INTERPOLATION_SPLINE){
+    for(uint8_t i = 0; i < 3; ++i){                                             // Cubic polynomial by Horner's method
+      int32_t value = multiply_fraction(e->spline[i][2], fraction) + e->spline[i][1];
+      value = multiply_fraction(value, fraction) + e->spline[i][0];
+      value = multiply_fraction(value, fraction) + e->start_point[i];
+      if(value < 0){                                                            // Spline overshoot saturation
+        value = 0;
+      }else if(value > (int32_t) U16_MAX){
+        value = U16_MAX;
+      }
+      e->current_color[i] = unpace(e, (uint16_t) value);
+    }
+    return;
+  }
+  hue_difference = e->destination_point[0] - e->start_point[0];
+  if(hue_difference < 0x8000){                                                  // The shortest hue path
+    hsv[0] = e->start_point[0] + (uint16_t) ((((uint32_t) hue_difference) * fraction) >> 16);
+  }else{
+    hsv[0] = e->start_point[0] - (uint16_t) ((((uint32_t) (uint16_t) -hue_difference) * fraction) >> 16);
+  }
+  for(uint8_t i = 1; i < 3; ++i){
+    hsv[i] = interpolate(e->start_point[i], e->destination_point[i], fraction);
+  }
+  hsv[2] = unpace(e, hsv[2]);
+  hsv_to_rgb(hsv, e->current_color);
+}
+
+/**
+@brief Mood lamp logic instance initialization
+@param[out] engine Mood lamp logic instance
+@param[in] first_channel Output channel of the instance red color constituent, green and blue 
+constituents use the next two channels
+@param[in] white_channel White output channel (HAL_PWM_NO_CHANNEL if white output is not used)
+*/
+void mood_engine_init(mood_engine_t *engine, uint8_t first_channel, uint8_t white_channel){
+  mood_engine_t *const e = MOOD_ENGINE(engine);
+  for(uint8_t i = 0; i < 3; ++i){
+    e->destination_color[i] = 0;
+    e->current_color[i] = 0;
+    e->start_color[i] = 0;
+  }
+  e->hold_ticks = 0;
+  e->transition_ticks = 0;
+  for(uint8_t j = 0; j < RGB_HISTORY_SIZE; ++j){                                // History is black (initial color)
+    for(uint8_t i = 0; i < 3; ++i){
+      e->history[j][i] = 0;
+    }
+  }
+  e->history_head = 0;
+  e->palette_phase = get_random_uint16();                                       // Instances start from different palette colors
+  for(uint8_t i = 0; i < RGB_LOOKAHEAD_SIZE; ++i){                              // Lookahead queue filling
+    e->lookahead_scheme[i] = pick_color(e, e->lookahead_color[i]);
+  }
+  e->lookahead_head = 0;
+  e->color_scheme = RGB_ONE_COLOR_SCHEME;
+  e->interpolation = RGB_INTERPOLATION_LINEAR;
+  e->easing = EASING_LINEAR;
+  e->pacing = RGB_PACING_UNIFORM;
+  e->first_call = 1;
+  e->frozen = 0;
+  e->first_channel = first_channel;
+  e->white_channel = white_channel;
+  e->output_changed = 1;                                                        // Initial color must be output
+}
 
 /**
 @brief Mood lamp logic handler
-@details This function handles one color changing step and destination color changig
+@details This function handles one color changing step and destination color changig. Current 
+color is converted into PWM levels by the output stage. New destination color is taken from the 
+lookahead queue, the queue is refilled by the new random color.
+@param[in,out] engine Mood lamp logic instance
 @note This function should be called at regular time intervals 
 @f$T=1000000T_{cycle}/(PWM_{max}+1)@f$ microseconds,
 where @f$T_{cycle}@f$ - time of one full color flowing, seconds; 
 @f$PWM_{max}@f$ - maximal color output PWM timer walue.
+@return 1 if destination color was changed, 0 otherwise
 */
-void rgb_handle(){
-  static uint8_t first_call = 1;                                                // First function call flag
-  uint16_t need_new_color = 1;                                                  // Destination color change flag
-  for(uint8_t i = 0; i < 3; ++i){                                               // Make one power step for every color channel
-    if(current_color[i] < destination_color[i]){
-      set_rgbw_output_value(i, ++current_color[i]);
-      need_new_color = 0;
-    }else if(current_color[i] > destination_color[i]){
-      set_rgbw_output_value(i, --current_color[i]);
-      need_new_color = 0;
+uint8_t rgb_handle(mood_engine_t *engine){
+  mood_engine_t *const e = MOOD_ENGINE(engine);
+  uint8_t need_new_color = 1;                                                   // Destination color change flag
+  if(e->frozen) return 0;                                                       // Color flow is frozen by command
+  if(e->hold_ticks){                                                            // Reached color is being held (for color flowing smoothing)
+    --e->hold_ticks;
+    return 0;
+  }
+  if(transition_is_stepping(e)){
+    for(uint8_t i = 0; i < 3; ++i){                                             // Make one power step for every color channel
+      if(e->current_color[i] < e->destination_color[i]){
+        ++e->current_color[i];
+        need_new_color = 0;
+      }else if(e->current_color[i] > e->destination_color[i]){
+        --e->current_color[i];
+        need_new_color = 0;
+      }
     }
+  }else if(e->transition_ticks){                                                // Make one interpolation step
+    transition_step(e);
+    need_new_color = 0;
   }
+  if(!need_new_color) e->output_changed = 1;                                    // Current color was changed
   if(need_new_color){                                                           // If destination color was reached
-    need_new_color = get_random_uint16() % (    RGB_ONE_COLOR_PROBABILITY +\
-                                                RGB_TWO_COLORS_PROBABILITY +\
-                                                RGB_THREE_COLORS_PROBABILITY +\
-                                                RGB_ONE_COLOR_AND_RANDOM_PROBABILITY +\
-                                                RGB_TWO_COLORS_AND_RANDOM_PROBABILITY); // Choose random color scheme for new destination color
-    if(need_new_color < RGB_ONE_COLOR_PROBABILITY){                             // Only one random color channel full power color scheme
-      for(uint8_t i = 0; i < 3; ++i){
-        destination_color[i] = 0;
-      }
-      destination_color[get_random_uint16() % 3] = U16_MAX;
-    }else if(need_new_color < ( RGB_ONE_COLOR_PROBABILITY +\
-                                RGB_TWO_COLORS_PROBABILITY)){                   // Only two random color channels full power color scheme
-      for(uint8_t i = 0; i < 3; ++i){
-        destination_color[i] = U16_MAX;
-      }
-      destination_color[get_random_uint16() % 3] = 0;
-    }else if(need_new_color < ( RGB_ONE_COLOR_PROBABILITY +\
-                                RGB_TWO_COLORS_PROBABILITY +\
-                                RGB_THREE_COLORS_PROBABILITY)){                 // Three (all) color channels full power color scheme
-      for(uint8_t i = 0; i < 3; ++i){
-        destination_color[i] = U16_MAX;
+    uint8_t head = e->lookahead_head;
+    for(uint8_t i = 0; i < 3; ++i){
+      e->destination_color[i] = e->lookahead_color[head][i];
+    }
+    e->color_scheme = e->lookahead_scheme[head];
+    e->lookahead_scheme[head] = pick_color(e, e->lookahead_color[head]);        // Queue refilling
+    e->lookahead_head = (head + 1) % RGB_LOOKAHEAD_SIZE;
+    transition_start(e);
+    if(!e->first_call && (e->interpolation != RGB_INTERPOLATION_SPLINE)){       // Hold reached color if destination color was changed (for color flowing smoothing)
+      e->hold_ticks = mood_config.color_hold_ticks;
+    }
+    e->first_call = 0;                                                          // Next function call will not first
+    return 1;
+  }
+  return 0;
+}
+
+/**
+@brief Destination color setter
+@details Sets destination color directly, mood lamp logic flows to it and chooses the next random 
+destination color after it was reached.
+@param[in,out] engine Mood lamp logic instance
+@param[in] color Destination color channels PWM values {R, G, B}
+*/
+void set_destination_color(mood_engine_t *engine, const uint16_t *color){
+  mood_engine_t *const e = MOOD_ENGINE(engine);
+  for(uint8_t i = 0; i < 3; ++i){
+    e->destination_color[i] = color[i];
+  }
+  e->hold_ticks = 0;                                                            // Start flowing immediately
+  e->color_scheme = RGB_COMMAND_SCHEME;
+  transition_start(e);
+}
+
+/**
+@brief Color flow freeze control
+@param[in,out] engine Mood lamp logic instance
+@param[in] freeze 1 - stop color flowing at the current color, 0 - continue color flowing
+*/
+void set_freeze(mood_engine_t *engine, uint8_t freeze){
+  MOOD_ENGINE(engine)->frozen = freeze;
+}
+
+/**
+@brief Integer square root rounded up
+@param[in] x Radicand
+@return The smallest r for which @f$r^2 \ge x@f$
+*/
+static uint32_t sqrt_ceil(uint32_t x){
+  uint32_t root = 0;
+  for(uint32_t bit = 1UL << 30; bit; bit >>= 2){                                // Bitwise floor square root
+    if(x >= root + bit){
+      x -= root + bit;
+      root = (root >> 1) + bit;
+    }else{
+      root >>= 1;
+    }
+  }
+  return x ? root + 1 : root;                                                   // Non-zero remainder - root is not exact
+}
+
+/**
+@brief Output level of the color channel value
+@details Apparent brightness linearization with master brightness, exactly as the output stage 
+calculates it (see output_handle()).
+@param[in] c Color channel value
+@return Output level
+*/
+static uint32_t rgb_level(uint32_t c){
+  uint32_t dimmed = c;
+  if(mood_config.brightness != U8_MAX) dimmed = (c * mood_config.brightness) >> 8;
+  return (c * dimmed) >> 16;
+}
+
+/**
+@brief Output level boundary calculation
+@details Full brightness level boundary is the exact square root. Dimmed level takes the rounded 
+down dimmed value, so the square root is a lower bound, which is refined by no more than 
+RGB_LEVEL_REFINE steps (about 128 / brightness steps are needed).
+@param[in] level Output level
+@return The smallest color channel value with the output level not less than the specified one 
+(if the refinement is not finished, a smaller value with lower output level), 0x10000 if the level 
+is above the output level range
+*/
+static uint32_t rgb_level_start(uint32_t level){
+  uint32_t c;
+  uint32_t radicand;
+  if(mood_config.brightness == U8_MAX) return sqrt_ceil(level << 16);
+  if(!mood_config.brightness) return 0x10000UL;                                 // Output is turned off, every level is 0
+  radicand = (level << 16) / mood_config.brightness;
+  if(radicand >= 0x1000000UL) return 0x10000UL;                                 // Level is not reached even by U16_MAX
+  c = sqrt_ceil(radicand << 8);
+  for(uint8_t i = 0; (i < RGB_LEVEL_REFINE) && (c <= U16_MAX) && (rgb_level(c) < level); ++i){
+    ++c;
+  }
+  return c;
+}
+
+/**
+@brief Ticks to the next output change calculation
+@details Calculates how many handler calls leave the output levels unchanged: the remaining hold 
+time and, for one LSB channels stepping, the linearization plateau (output level of the color 
+channel value with master brightness, see rgb_level(), changes only when the value crosses the 
+next level boundary). Progress-based transitions change the color every tick. Destination color 
+reaching is counted as a change, so the new destination is chosen in time.
+@param[in] engine Mood lamp logic instance
+@return Ticks to the next output change (1 - the next tick changes it, U16_MAX if there are no 
+changes in sight)
+@note Color correction, RGBW conversion and power limitation are applied to the output levels, 
+so they can only merge the plateaus and the result is never too late. Master brightness ramp is 
+handled by the scheduler, which does not sleep until the output stage settles.
+*/
+uint16_t rgb_ticks_to_change(const mood_engine_t *engine){
+  const mood_engine_t *const e = MOOD_ENGINE(engine);
+  uint32_t ticks = U16_MAX;
+  if(e->frozen) return U16_MAX;                                                 // Frozen color does not change
+  if(!transition_is_stepping(e)){
+    ticks = 1;                                                                  // Progress-based transition or the new destination choice
+  }else{
+    for(uint8_t i = 0; i < 3; ++i){
+      uint32_t c = e->current_color[i];
+      uint32_t level = rgb_level(c);
+      uint32_t start;
+      uint32_t channel_ticks;
+      if(c < e->destination_color[i]){                                          // The next level boundary upwards
+        start = rgb_level_start(level + 1);                                     // Lower bound is safe: it is only an earlier wakeup
+        channel_ticks = (start > c) ? start - c : 1;
+        if(channel_ticks > e->destination_color[i] - c) channel_ticks = e->destination_color[i] - c;
+      }else if(c > e->destination_color[i]){                                    // The current level boundary downwards
+        channel_ticks = c - e->destination_color[i];
+        if(level){
+          start = rgb_level_start(level);
+          if(rgb_level(start) < level){
+            channel_ticks = 1;                                                  // Boundary is not found exactly, it can not be skipped
+          }else if(c + 1 - start < channel_ticks){
+            channel_ticks = c + 1 - start;
+          }
+        }
+      }else{
+        continue;
       }
-    }else if(need_new_color < ( RGB_ONE_COLOR_PROBABILITY +\
-                                RGB_TWO_COLORS_PROBABILITY +\
-                                RGB_THREE_COLORS_PROBABILITY +\
-                                RGB_ONE_COLOR_AND_RANDOM_PROBABILITY)){         // One random color channel full power, another color channels - random power color scheme
-      for(uint8_t i = 0; i < 3; ++i){
-        destination_color[i] = get_random_uint16();
+      if(channel_ticks < ticks) ticks = channel_ticks;
+    }
+    if(ticks == U16_MAX) ticks = 1;                                             // Destination is reached, the next tick chooses the new one
+  }
+  ticks += e->hold_ticks;
+  return (ticks > U16_MAX) ? U16_MAX : (uint16_t) ticks;
+}
+
+/**
+@brief Ticks skipping
+@details Advances the mood lamp logic state by the specified number of ticks at once, as if the 
+handler was called every tick. It is intended to skip ticks which do not change the output 
+(see rgb_ticks_to_change()), so new destination color is never chosen here.
+@param[in,out] engine Mood lamp logic instance
+@param[in] ticks Ticks to be skipped
+*/
+void rgb_skip(mood_engine_t *engine, uint16_t ticks){
+  mood_engine_t *const e = MOOD_ENGINE(engine);
+  if(e->frozen || !ticks) return;
+  if(e->hold_ticks){                                                            // Hold time goes first
+    uint16_t hold = (e->hold_ticks > ticks) ? ticks : (uint16_t) e->hold_ticks;
+    e->hold_ticks -= hold;
+    ticks -= hold;
+    if(!ticks) return;
+  }
+  if(transition_is_stepping(e)){
+    for(uint8_t i = 0; i < 3; ++i){                                             // All steps of every channel at once
+      if(e->current_color[i] < e->destination_color[i]){
+        uint16_t difference = e->destination_color[i] - e->current_color[i];
+        e->current_color[i] += (difference > ticks) ? ticks : difference;
+      }else{
+        uint16_t difference = e->current_color[i] - e->destination_color[i];
+        e->current_color[i] -= (difference > ticks) ? ticks : difference;
       }
-      destination_color[get_random_uint16() % 3] = U16_MAX;
-    }else{                                                                      // One random color channel random power, another color channels - full power color scheme
-      for(uint8_t i = 0; i < 3; ++i){
-        destination_color[i] = U16_MAX;
+    }
+  }else if(e->transition_ticks){
+    uint16_t leap = ticks - 1;                                                  // Only the last skipped tick color is calculated
+    if(leap >= e->transition_ticks) leap = e->transition_ticks - 1;
+    e->transition_ticks -= leap;
+    e->progress += ((uint32_t) leap) * e->progress_step;
+    transition_step(e);
+  }
+  e->output_changed = 1;
+}
+
+/**
+@brief Ticks before the next destination color choice calculation
+@param[in] e Mood lamp logic instance
+@return Handler calls which do not choose a new destination color (U32_MAX if color is frozen)
+*/
+static uint32_t rgb_quiet_ticks(const mood_engine_t *e){
+  uint32_t quiet = e->hold_ticks;
+  if(e->frozen) return U32_MAX;                                                 // Frozen color never chooses
+  if(!transition_is_stepping(e)){
+    quiet += e->transition_ticks;
+  }else{
+    uint16_t length = 0;
+    for(uint8_t i = 0; i < 3; ++i){                                             // Stepping transition length is the longest channel path
+      uint16_t difference = (e->current_color[i] > e->destination_color[i]) ?\
+        e->current_color[i] - e->destination_color[i] : e->destination_color[i] - e->current_color[i];
+      if(difference > length) length = difference;
+    }
+    quiet += length;
+  }
+  return quiet;
+}
+
+/**
+@brief Ticks advancing
+@details Advances all mood lamp logic instances by the specified number of ticks, exactly as the 
+handlers called every tick do (new destination colors are chosen on time, in the same instances 
+order and take the same random numbers), but skips hold time and transitions at once. It is 
+intended to catch up with another lamp, so only the ticks which choose new destination colors 
+are handled one by one.
+@param[in] ticks Ticks to be advanced
+@note Instances share one random numbers generator, so they are interleaved by the next choice 
+time rather than advanced one after another
+*/
+void rgb_advance(uint32_t ticks){
+  while(ticks){
+    uint32_t quiet = ticks;                                                     // Ticks before the nearest choice among all instances
+    for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){
+      uint32_t engine_quiet = rgb_quiet_ticks(&mood_engines[i]);
+      if(engine_quiet < quiet) quiet = engine_quiet;
+    }
+    if(!quiet){
+      for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){                         // The choosing tick, handled as the main cycle does
+        rgb_handle(&mood_engines[i]);
       }
-      destination_color[get_random_uint16() % 3] = get_random_uint16();
+      --ticks;
+      continue;
+    }
+    if(quiet > U16_MAX) quiet = U16_MAX;
+    for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){
+      rgb_skip(&mood_engines[i], (uint16_t) quiet);
     }
-    if(!first_call) for(uint32_t i = 0; i < 500000; ++i);                       // Delay if destination color was changed (for color flowing smoothing)
+    ticks -= quiet;
   }
-  first_call = 0;                                                               // Next function call will not first
 }
 
-///@}
\ No newline at end of file
+/**
+@brief Current color getter
+@param[in] engine Mood lamp logic instance
+@param[in] channel Channel number (0...2)
+@return Channel current PWM value
+*/
+uint16_t get_current_color(const mood_engine_t *engine, uint8_t channel){
+  return MOOD_ENGINE(engine)->current_color[channel];
+}
+
+/**
+@brief Destination color getter
+@param[in] engine Mood lamp logic instance
+@param[in] channel Channel number (0...2)
+@return Channel destination PWM value
+*/
+uint16_t get_destination_color(const mood_engine_t *engine, uint8_t channel){
+  return MOOD_ENGINE(engine)->destination_color[channel];
+}
+
+/**
+@brief Color scheme getter
+@param[in] engine Mood lamp logic instance
+@return Color scheme of the destination color (RGB_ONE_COLOR_SCHEME...RGB_PALETTE_SCHEME)
+*/
+uint8_t get_color_scheme(const mood_engine_t *engine){
+  return MOOD_ENGINE(engine)->color_scheme;
+}
+
+///@}
@@ -25,7 +25,8 @@
 #ifndef __MOOD_LOGIC_H__
 #define __MOOD_LOGIC_H__
 
-//#include <stm8s.h>
+#include <stm8s.h>
+#include "easing.h"
 
 /**
 @defgroup mood_lamp_logic Mood lamp logic
@@ -36,7 +37,12 @@
 /**
 @defgroup mood_lamp_parameters Mood lamp parameters
 @ingroup mood_lamp_logic
-@brief Consists shares of various color schemes in total value
+@brief Consists default values of runtime configuration: shares of various color schemes in total value, color flow speed, color hold time, destination sampling mode, interpolation mode, easing curve and pacing
+@details Default hold time keeps the original hold of 500000 iterations of the 32-bit counter 
+delay loop. Iteration of the 32-bit counter loop takes about twice as long as iteration of the 
+16-bit counter loop of the color flow speed regulation, and the loop mode tick is dominated by 
+RGB_COLOR_FLOW_DELAY iterations of the latter, so the hold is 500000 * 2 / 200 = 5000 loop mode 
+ticks. In the timer modes the same 5000 ticks of 128us are 640ms.
 @{
 */
 #define RGB_ONE_COLOR_PROBABILITY               2                               ///< Only one random color channel full power color scheme share
@@ -44,9 +50,171 @@
 #define RGB_THREE_COLORS_PROBABILITY            1                               ///< Three (all) color channels full power color scheme share
 #define RGB_ONE_COLOR_AND_RANDOM_PROBABILITY    1                               ///< One random color channel full power, another color channels - random power color scheme share
 #define RGB_TWO_COLORS_AND_RANDOM_PROBABILITY   1                               ///< One random color channel random power, another color channels - full power color scheme share
+#define RGB_COLOR_FLOW_DELAY                    200                             ///< Main cycle delay loop iterations (color flow speed regulation)
+#define RGB_COLOR_HOLD_TICKS                    5000                            ///< Color hold time, ticks (500000 * 2 / RGB_COLOR_FLOW_DELAY, see above)
+#define RGB_SAMPLING                            RGB_SAMPLING_SCHEMES            ///< Random destination colors sampling mode
+#define RGB_PALETTE                             0                               ///< Palette of the palette sampling mode (see palette.h)
+#define RGB_MIN_DISTANCE                        0x2000                          ///< Minimal perceptual distance between the new destination color and the recent ones (0 - no limitation)
+#define RGB_INTERPOLATION                       RGB_INTERPOLATION_LINEAR        ///< Interpolation mode
+#define RGB_EASING                              EASING_LINEAR                   ///< Easing curve (EASING_LINEAR...EASING_EXPONENTIAL or RGB_EASING_RANDOM)
+#define RGB_PACING                              RGB_PACING_UNIFORM              ///< Pacing mode
 ///@}
 
-void rgb_handle();
+/**
+@defgroup mood_lamp_schemes Mood lamp color schemes
+@ingroup mood_lamp_logic
+@brief Consists color schemes identifiers
+@{
+*/
+#define RGB_ONE_COLOR_SCHEME                    0                               ///< Only one random color channel full power color scheme
+#define RGB_TWO_COLORS_SCHEME                   1                               ///< Only two random color channels full power color scheme
+#define RGB_THREE_COLORS_SCHEME                 2                               ///< Three (all) color channels full power color scheme
+#define RGB_ONE_COLOR_AND_RANDOM_SCHEME         3                               ///< One random color channel full power, another color channels - random power color scheme
+#define RGB_TWO_COLORS_AND_RANDOM_SCHEME        4                               ///< One random color channel random power, another color channels - full power color scheme
+#define RGB_COMMAND_SCHEME                      5                               ///< Destination color was set by command
+#define RGB_OKLAB_SCHEME                        6                               ///< Destination color was sampled uniformly in OKLab
+#define RGB_PALETTE_SCHEME                      7                               ///< Destination color was taken from the palette
+#define RGB_SCHEMES_NUMBER                      5                               ///< Random color schemes quantity
+///@}
+
+/**
+@defgroup mood_lamp_sampling Mood lamp sampling modes
+@ingroup mood_lamp_logic
+@brief Consists random destination colors sampling modes identifiers
+@details Color schemes produce mostly saturated primaries and the pseudowhite from the RGB cube 
+edges. OKLab sampling takes random sample from the flash table of colors spread uniformly over 
+the gamut in the perceptually uniform OKLab space, so pastel colors and mid-tones appear as often 
+as any other colors. tools/coverage_report.py compares the gamut coverage of both modes.
+
+Palette sampling takes colors of the selected flash-resident palette (see palette.h) instead of 
+color schemes. Palette index is the golden ratio low-discrepancy sequence: phase is increased by 
+@f$2^{16}/\varphi@f$ every pick and scaled to the palette size by one byte multiplication, so 
+every short window of picks covers the whole palette evenly, and selection needs no division.
+@{
+*/
+#define RGB_SAMPLING_SCHEMES                    0                               ///< Random color scheme according to schemes shares
+#define RGB_SAMPLING_OKLAB                      1                               ///< Uniform OKLab gamut sampling
+#define RGB_SAMPLING_PALETTE                    2                               ///< Palette colors golden ratio sequence
+#define RGB_SAMPLINGS_NUMBER                    3                               ///< Sampling modes quantity
+#define RGB_GOLDEN_RATIO_STEP                   0x9E37                          ///< Palette phase increment, 2^16/golden ratio
+///@}
+
+/**
+@defgroup mood_lamp_interpolation Mood lamp interpolation modes
+@ingroup mood_lamp_logic
+@brief Consists interpolation modes identifiers
+@details Interpolation mode defines the path from the current color to the destination color:
+- linear: every color channel steps by one LSB per tick independently, channels with smaller 
+difference reach their destination values earlier;
+- HSV: hue, saturation and value are interpolated simultaneously, hue takes the shortest path 
+around the color circle, so midpoints keep their saturation (for example, red to cyan transition 
+passes yellow and green instead of gray). Transition takes the same number of ticks as the 
+linear one;
+- spline: color channels follow uniform Catmull-Rom spline through the previous waypoint, the 
+current color, the destination color and the next destination color from the lookahead queue. 
+Color flows through waypoints without stops (color hold is not used), trajectory has no corners.
+
+Every mode can be combined with the easing curve applied to the transition progress. Linear 
+mode with non-constant velocity easing interpolates all channels simultaneously, so they reach 
+the destination together. Easing curve can be chosen randomly for every transition.
+
+Pacing defines the coordinates of interpolation: uniform pacing interpolates color channels values 
+(HSV value), lightness pacing interpolates their apparent lightness @f$l=v^{2/3}@f$. Lightness 
+derivative is the highest near black, so lightness pacing spends more ticks at low levels, where 
+every step is visible, and less ticks near full brightness. Total transition time is not changed.
+
+Mode, easing curve and pacing are latched at the transition start, so their change does not break the 
+current transition.
+@{
+*/
+#define RGB_INTERPOLATION_LINEAR                0                               ///< Independent channels stepping
+#define RGB_INTERPOLATION_HSV                   1                               ///< HSV interpolation with the shortest hue path
+#define RGB_INTERPOLATION_SPLINE                2                               ///< Catmull-Rom spline through the lookahead waypoints
+#define RGB_INTERPOLATIONS_NUMBER               3                               ///< Interpolation modes quantity
+#define RGB_EASING_RANDOM                       EASINGS_NUMBER                  ///< Random easing curve for every transition
+#define RGB_PACING_UNIFORM                      0                               ///< Uniform color channels values pace
+#define RGB_PACING_LIGHTNESS                    1                               ///< Uniform apparent lightness pace
+#define RGB_PACINGS_NUMBER                      2                               ///< Pacing modes quantity
+///@}
+
+/**
+@defgroup mood_lamp_engine Mood lamp logic instance
+@ingroup mood_lamp_logic
+@brief Consists mood lamp logic context
+@details All mood lamp logic state is kept in the context structure, so several independent 
+lamps (zones) can be driven by one MCU or simulated in one host process. Single-instance build 
+(MOOD_ENGINES_NUMBER is 1) uses the only context by its constant address and ignores context 
+pointer arguments, so it has no pointer indirection overhead.
+
+Random destination colors are generated RGB_LOOKAHEAD_SIZE destinations ahead and kept in the 
+lookahead queue, so interpolation can use the future waypoints. Color schemes shares changes are 
+applied with the same delay.
+
+Generated colors are kept in the history ring of RGB_HISTORY_SIZE colors. Random color is redrawn 
+if its perceptual distance to any recent color is less than the configured minimal distance, so 
+the same destination is not repeated. Distance is the sum of apparent lightness differences of 
+color channels (U16_MAX per channel). No more than RGB_PICK_ATTEMPTS colors are drawn, if all of 
+them are too close, the farthest one is used, so worst-case pick time is bounded.
+@{
+*/
+#ifndef MOOD_ENGINES_NUMBER
+ #define MOOD_ENGINES_NUMBER                    1                               ///< Mood lamp logic instances quantity (host checks may override it)
+#endif
+#define RGB_LOOKAHEAD_SIZE                      2                               ///< Lookahead queue length, destination colors
+#define RGB_HISTORY_SIZE                        2                               ///< History ring length, colors
+#define RGB_PICK_ATTEMPTS                       4                               ///< Maximal random colors draws per pick
+#define RGB_LEVEL_REFINE                        8                               ///< Maximal dimmed level boundary refinement steps
+
+/**
+@brief Mood lamp logic context
+*/
+typedef struct{
+  uint16_t destination_color[3];                                                ///< Color channels destination PWM values {R, G, B}
+  uint16_t current_color[3];                                                    ///< Color channels current PWM values {R, G, B}
+  uint16_t start_color[3];                                                      ///< Transition start color (the previous waypoint) {R, G, B}
+  int32_t spline[3][3];                                                         ///< Spline polynomial coefficients of t, t^2, t^3 for every color channel
+  uint16_t lookahead_color[RGB_LOOKAHEAD_SIZE][3];                              ///< Lookahead queue of the next destination colors
+  uint8_t lookahead_scheme[RGB_LOOKAHEAD_SIZE];                                 ///< Color schemes of the lookahead queue colors
+  uint8_t lookahead_head;                                                       ///< Lookahead queue head (the next destination) index
+  uint16_t history[RGB_HISTORY_SIZE][3];                                        ///< History ring of the recent generated colors apparent lightness
+  uint8_t history_head;                                                         ///< History ring the oldest color index
+  uint16_t palette_phase;                                                       ///< Palette sampling low-discrepancy sequence phase
+  uint16_t start_point[3];                                                      ///< Transition start in the interpolation coordinates
+  uint16_t destination_point[3];                                                ///< Transition destination in the interpolation coordinates
+  uint32_t progress;                                                            ///< Passed part of the transition (0...U32_MAX)
+  uint32_t progress_step;                                                       ///< Transition progress increment per tick
+  uint16_t transition_ticks;                                                    ///< Remaining transition time, ticks
+  uint32_t hold_ticks;                                                          ///< Remaining reached color hold time, ticks
+  uint8_t color_scheme;                                                         ///< Color scheme of the destination color
+  uint8_t interpolation;                                                        ///< Interpolation mode of the current transition
+  uint8_t easing;                                                               ///< Easing curve of the current transition
+  uint8_t pacing;                                                               ///< Pacing mode of the current transition
+  uint8_t first_call;                                                           ///< First handler call flag
+  uint8_t frozen;                                                               ///< Color flow freeze flag
+  uint8_t first_channel;                                                        ///< Output channel of the red color constituent
+  uint8_t white_channel;                                                        ///< White output channel (HAL_PWM_NO_CHANNEL if white output is not used)
+  uint8_t output_changed;                                                       ///< Current color change flag for the output stage
+}mood_engine_t;
+
+extern mood_engine_t mood_engines[MOOD_ENGINES_NUMBER];
+
+#if MOOD_ENGINES_NUMBER == 1
+ #define MOOD_ENGINE(engine)                    ((void) (engine), &mood_engines[0]) ///< Single-instance build: context has constant address
+#else
+ #define MOOD_ENGINE(engine)                    (engine)                        ///< Multi-instance build: context is passed by pointer
+#endif
+///@}
+
+void mood_engine_init(mood_engine_t *engine, uint8_t first_channel, uint8_t white_channel);
+uint8_t rgb_handle(mood_engine_t *engine);
+uint16_t get_current_color(const mood_engine_t *engine, uint8_t channel);
+uint16_t get_destination_color(const mood_engine_t *engine, uint8_t channel);
+uint8_t get_color_scheme(const mood_engine_t *engine);
+void set_destination_color(mood_engine_t *engine, const uint16_t *color);
+void set_freeze(mood_engine_t *engine, uint8_t freeze);
+uint16_t rgb_ticks_to_change(const mood_engine_t *engine);
+void rgb_skip(mood_engine_t *engine, uint16_t ticks);
+void rgb_advance(uint32_t ticks);
 
 ///@}
 
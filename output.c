@@ -0,0 +1,224 @@
+/**
+@file           output.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists output stage.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "output.h"
+#include "hal.h"
+#include "config.h"
+#include "profiler.h"
+
+/**
+@addtogroup output
+@{
+*/
+
+static const uint16_t white_gain[3] = {
+  OUTPUT_WHITE_GAIN_R,
+  OUTPUT_WHITE_GAIN_G,
+  OUTPUT_WHITE_GAIN_B
+};                                                                              ///< RGB equivalent of the white LED light
+
+static uint16_t output_levels[HAL_PWM_CHANNELS_NUMBER];                         ///< Output levels before power limitation
+static uint32_t output_sum;                                                     ///< Sum of all output levels
+static uint16_t output_scale = U16_MAX;                                         ///< Power limitation scale (U16_MAX - no limitation)
+static uint8_t output_levels_changed;                                           ///< Output levels were changed since the last update
+static uint8_t output_brightness;                                               ///< Current master brightness
+static uint8_t output_brightness_changed;                                       ///< Master brightness was changed during the last update
+static uint8_t output_brightness_ticks;                                         ///< Ticks since the last master brightness ramp step
+static uint8_t output_settled;                                                  ///< Master brightness and power limitation scale reached their targets
+
+/**
+@brief Word by byte multiplication
+@details STM8 core has only 8x8 hardware multiplier, so product is collected from two 8x8 
+multiplications instead of the library 32x32 multiplication call.
+@param[in] a Word multiplicand
+@param[in] b Byte multiplier
+@return a * b
+*/
+static uint32_t multiply_16x8(uint16_t a, uint8_t b){
+  return (((uint32_t) ((uint16_t) ((uint8_t) (a >> 8)) * b)) << 8) + (uint16_t) ((uint8_t) a) * b;
+}
+
+/**
+@brief Level by Q2.14 coefficient multiplication
+@param[in] level Linear brightness level
+@param[in] coefficient Q2.14 coefficient
+@return level * coefficient / 256 (6 fractional bits are kept, so sum of three products can not 
+overflow)
+*/
+static int32_t multiply_q14(uint16_t level, int16_t coefficient){
+  uint16_t magnitude = (coefficient < 0) ? -(uint16_t) coefficient : (uint16_t) coefficient;
+  int32_t product = (int32_t) (multiply_16x8(level, (uint8_t) (magnitude >> 8)) +\
+    (multiply_16x8(level, (uint8_t) magnitude) >> 8));
+  return (coefficient < 0) ? -product : product;
+}
+
+/**
+@brief Color correction
+@details Multiplies linear levels by the color correction matrix with saturation. Zero 
+coefficients are skipped, so diagonal (white balance only) matrix costs three multiplications.
+@param[in,out] level Linear levels {R, G, B}
+*/
+static void output_correct(uint16_t *level){
+  uint16_t input[3];
+  for(uint8_t i = 0; i < 3; ++i){
+    input[i] = level[i];
+  }
+  for(uint8_t i = 0; i < 3; ++i){
+    int32_t sum = 0;
+    for(uint8_t j = 0; j < 3; ++j){
+      if(mood_config.color_matrix[i][j]) sum += multiply_q14(input[j], mood_config.color_matrix[i][j]);
+    }
+    if(sum <= 0){                                                               // Saturation
+      level[i] = 0;
+    }else if(sum >= (((int32_t) U16_MAX) << 6)){
+      level[i] = U16_MAX;
+    }else{
+      level[i] = (uint16_t) (sum >> 6);
+    }
+  }
+}
+
+/**
+@brief Output level setter
+@details Stores output level and keeps the sum of all levels up to date, so it is not recalculated 
+every tick.
+@param[in] channel PWM channel number
+@param[in] level Output level
+*/
+static void output_set(uint8_t channel, uint16_t level){
+  if(channel >= HAL_PWM_CHANNELS_NUMBER) return;
+  output_sum = output_sum - output_levels[channel] + level;
+  output_levels[channel] = level;
+  output_levels_changed = 1;
+}
+
+/**
+@brief Output stage initialization
+@details Sets master brightness to its configuration value without ramp.
+@note This function should be called once at power-on after the configuration loading
+*/
+void output_init(){
+  output_brightness = mood_config.brightness;
+}
+
+/**
+@brief Output stage handler
+@details Converts the current color of the mood lamp logic instance into output levels of its 
+channels. Conversion is made only if the current color or master brightness was changed.
+@param[in,out] engine Mood lamp logic instance
+@note If gains are not greater than U16_MAX, subtraction can not underflow: every color channel 
+level is not less than W.
+*/
+void output_handle(mood_engine_t *engine){
+  mood_engine_t *const e = MOOD_ENGINE(engine);
+  uint16_t level[3];
+  if(!e->output_changed && !output_brightness_changed) return;                  // Nothing to convert
+  e->output_changed = 0;
+  for(uint8_t i = 0; i < 3; ++i){                                               // Apparent brightness linearization and dimming
+    uint16_t dimmed = e->current_color[i];
+    if(output_brightness != U8_MAX) dimmed = multiply_16x8(dimmed, output_brightness) >> 8;
+    level[i] = (((uint32_t) e->current_color[i]) * dimmed) >> 16;
+  }
+  if(!mood_config.color_matrix_identity){                                       // Color correction
+    uint16_t start = profiler_start();
+    output_correct(level);
+    profiler_stop(PROFILER_SLOT_CORRECTION, start);
+  }
+  if(e->white_channel != HAL_PWM_NO_CHANNEL){                                   // RGB to RGBW conversion
+    uint16_t white = level[0];
+    if(level[1] < white) white = level[1];
+    if(level[2] < white) white = level[2];
+    for(uint8_t i = 0; i < 3; ++i){
+      level[i] -= (((uint32_t) white) * white_gain[i] + white) >> 16;           // Gain is (value + 1) / 2^16, so U16_MAX is exactly 1.0
+    }
+    output_set(e->white_channel, white);
+  }
+  for(uint8_t i = 0; i < 3; ++i){
+    output_set(e->first_channel + i, level[i]);
+  }
+}
+
+/**
+@brief Master brightness ramp, power limitation and PWM levels setting
+@details Moves master brightness towards its configuration value, moves power limitation scale 
+towards its target value and sets PWM levels of all channels if levels or scale were changed. 
+Changed master brightness is applied by output stage handlers during the next tick.
+@note This function should be called once per tick after output stage handlers of all mood lamp 
+logic instances. Levels sum and limit are divided by 16 before division, so 9 fully turned on 
+channels are still in the 16-bit range.
+*/
+void output_update(){
+  uint32_t target = U16_MAX;
+  output_brightness_changed = 0;
+  if((output_brightness != mood_config.brightness) &&\
+    (++output_brightness_ticks >= OUTPUT_BRIGHTNESS_RAMP_TICKS)){               // Master brightness ramp
+    output_brightness_ticks = 0;
+    output_brightness += (output_brightness < mood_config.brightness) ? 1 : -1;
+    output_brightness_changed = 1;
+  }
+  if(output_sum > OUTPUT_POWER_LIMIT){                                          // Power limit is exceeded
+    target = (((uint32_t) (OUTPUT_POWER_LIMIT >> 4)) << 16) / (uint16_t) (output_sum >> 4);
+    if(target > U16_MAX) target = U16_MAX;
+  }
+  if(output_scale < target){                                                    // Slew limitation
+    output_scale = ((target - output_scale) > OUTPUT_POWER_SLEW) ? output_scale + OUTPUT_POWER_SLEW : (uint16_t) target;
+    output_levels_changed = 1;
+  }else if(output_scale > target){
+    output_scale = ((output_scale - target) > OUTPUT_POWER_SLEW) ? output_scale - OUTPUT_POWER_SLEW : (uint16_t) target;
+    output_levels_changed = 1;
+  }
+  output_settled = (output_brightness == mood_config.brightness) && (output_scale == target);
+  if(!output_levels_changed) return;
+  output_levels_changed = 0;
+  for(uint8_t i = 0; i < HAL_PWM_CHANNELS_NUMBER; ++i){
+    if(output_scale == U16_MAX){                                                // No limitation
+      set_rgbw_output_value(i, output_levels[i]);
+    }else{
+      set_rgbw_output_value(i, (((uint32_t) output_levels[i]) * output_scale) >> 16);
+    }
+  }
+}
+
+/**
+@brief Output stage idle state getter
+@details Master brightness ramp and power limitation slew change PWM levels without mood lamp 
+logic color changes, so ticks can not be skipped until both of them are finished.
+@return 1 - master brightness and power limitation scale reached their targets during the last 
+update, 0 - output stage changes PWM levels by itself
+*/
+uint8_t output_is_settled(){
+  return output_settled;
+}
+
+/**
+@brief Output level getter
+@param[in] channel PWM channel number
+@return Output level after power limitation (the value set to the PWM channel)
+*/
+uint16_t get_output_level(uint8_t channel){
+  if(output_scale == U16_MAX) return output_levels[channel];
+  return (((uint32_t) output_levels[channel]) * output_scale) >> 16;
+}
+
+///@}
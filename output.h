@@ -0,0 +1,76 @@
+/**
+@file           output.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists output stage interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __OUTPUT_H__
+#define __OUTPUT_H__
+
+#include <stm8s.h>
+#include "mood_logic.h"
+#include "hal.h"
+
+/**
+@defgroup output Output stage
+@brief This module consists color processing between mood lamp logic and PWM outputs
+@details Output stage converts mood lamp logic colors into PWM levels:
+-# pseudoexponential (quadratic) apparent brightness linearization fused with the master dimmer: 
+@f$L=value \cdot (value \cdot B/256)/value_{max}@f$, where @f$B@f$ is the master brightness. 
+Brightness is applied to one multiplicand of the square by two 8x8 multiplications, so no extra 
+word multiplication per channel is needed (full brightness skips it at all). Brightness follows 
+its runtime configuration value by one step every OUTPUT_BRIGHTNESS_RAMP_TICKS ticks;
+-# color correction (white balance of the particular LED strip): @f$L'=M \cdot L@f$, where 
+@f$M@f$ is the 3x3 matrix of Q2.14 coefficients from the runtime configuration. Results are 
+saturated to 0...U16_MAX. Identity matrix skips this step;
+-# RGB to RGBW conversion (if white output is used): the white part of the color 
+@f$W=min(L_R,L_G,L_B)@f$ is moved to the white channel and its RGB equivalent 
+@f$W \cdot gain_{R,G,B}@f$ is subtracted from color channels. Conversion is made after 
+linearization, so the white LED replaces the same amount of light of the color LEDs;
+-# total power limitation: levels of all channels are summed (strip current is proportional to the 
+sum) and, if the sum exceeds OUTPUT_POWER_LIMIT, all channels are scaled proportionally. Scale 
+follows its target value with OUTPUT_POWER_SLEW step per tick, so limitation is smooth and does 
+not cause visible brightness pumping.
+@{
+*/
+
+#define OUTPUT_WHITE_ENABLE                     0                               ///< White output usage: 1 - RGBW strip, 0 - RGB strip (W output is unused)
+#define OUTPUT_WHITE_GAIN_R                     U16_MAX                         ///< Red light of the white LED relative to the red LED (0...U16_MAX, U16_MAX is 1.0)
+#define OUTPUT_WHITE_GAIN_G                     U16_MAX                         ///< Green light of the white LED relative to the green LED (0...U16_MAX, U16_MAX is 1.0)
+#define OUTPUT_WHITE_GAIN_B                     U16_MAX                         ///< Blue light of the white LED relative to the blue LED (0...U16_MAX, U16_MAX is 1.0)
+#define OUTPUT_BRIGHTNESS                       U8_MAX                          ///< Default master brightness (U8_MAX - full brightness)
+#define OUTPUT_BRIGHTNESS_RAMP_TICKS            4                               ///< Master brightness ramp period, ticks per step
+#define OUTPUT_POWER_LIMIT                      (3UL * U16_MAX)                 ///< Maximal sum of all channels levels (U16_MAX per fully turned on channel)
+#define OUTPUT_POWER_SLEW                       16                              ///< Maximal power limitation scale change per tick (scale U16_MAX is 1.0)
+
+#if OUTPUT_WHITE_ENABLE && (HAL_PWM_CHANNELS_NUMBER <= HAL_PWM_WHITE_CHANNEL)
+ #error "White output requires HAL_PWM_CHANNELS_NUMBER of 4 or more (see hal.h)"
+#endif
+
+void output_init();
+void output_handle(mood_engine_t *engine);
+void output_update();
+uint8_t output_is_settled();
+uint16_t get_output_level(uint8_t channel);
+
+///@}
+
+#endif /* __OUTPUT_H__ */
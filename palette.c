@@ -0,0 +1,78 @@
+/**
+@file           palette.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists color palettes.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "palette.h"
+
+/**
+@addtogroup palette
+@{
+*/
+
+/**
+@brief Palette descriptor
+*/
+typedef struct{
+  uint8_t first;                                                                ///< The first color index in the palettes colors table
+  uint8_t size;                                                                 ///< Colors quantity (1...PALETTE_MAX_SIZE)
+}palette_t;
+
+static const uint8_t palette_colors[][3] = {
+  {255,  40,   0}, {255,  90,   0}, {255, 140,  10}, {255, 180,  40},           // Warm: embers, amber and candle light
+  {230,  60,  30}, {255, 120,  60}, {200,  30,  10}, {255, 200, 110},
+  {  0,  60, 255}, {  0, 140, 255}, {  0, 220, 230}, {  0, 255, 170},           // Sea: deep blue, azure and turquoise
+  { 40, 100, 200}, { 90, 200, 255}, {  0, 180, 140}, {150, 255, 230},
+  { 20, 255,   0}, { 90, 255,  20}, {160, 230,   0}, {  0, 200,  60},           // Forest: leaves, moss and young grass
+  { 60, 160,  20}, {200, 255,  80}, {  0, 255, 120}, {120, 180,  40}
+};                                                                              ///< Palettes colors {R, G, B}
+
+static const palette_t palettes[PALETTES_NUMBER] = {
+  {0, 8},                                                                       // Warm
+  {8, 8},                                                                       // Sea
+  {16, 8}                                                                       // Forest
+};                                                                              ///< Palettes descriptors
+
+/**
+@brief Palette size getter
+@param[in] palette Palette number (0...PALETTES_NUMBER-1)
+@return Palette colors quantity
+*/
+uint8_t get_palette_size(uint8_t palette){
+  return palettes[palette].size;
+}
+
+/**
+@brief Palette color getter
+@param[in] palette Palette number (0...PALETTES_NUMBER-1)
+@param[in] index Color index within the palette
+@param[out] rgb Palette color {R, G, B}
+*/
+void get_palette_color(uint8_t palette, uint8_t index, uint16_t *rgb){
+  const uint8_t *color = palette_colors[palettes[palette].first + index];
+  for(uint8_t i = 0; i < 3; ++i){
+    rgb[i] = (((uint16_t) color[i]) << 8) | color[i];                           // 8-bit value scaling, 0xFF is U16_MAX
+  }
+}
+
+///@}
@@ -0,0 +1,49 @@
+/**
+@file           palette.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists color palettes interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __PALETTE_H__
+#define __PALETTE_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup palette Color palettes
+@brief This module consists flash-resident color palettes
+@details Palette is the curated set of destination colors (for example, brand-constrained color 
+range of the particular install). Palettes colors are kept in one flash table, 8-bit value per 
+color channel, palettes descriptors refer to their parts. Add your palettes to palette.c and 
+increase PALETTES_NUMBER.
+@{
+*/
+
+#define PALETTES_NUMBER                         3                               ///< Palettes quantity
+#define PALETTE_MAX_SIZE                        64                              ///< Maximal palette colors quantity
+
+uint8_t get_palette_size(uint8_t palette);
+void get_palette_color(uint8_t palette, uint8_t index, uint16_t *rgb);
+
+///@}
+
+#endif /* __PALETTE_H__ */
@@ -0,0 +1,121 @@
+/**
+@file           profiler.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists execution time profiler.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "profiler.h"
+#include "hal.h"
+
+/**
+@addtogroup profiler
+@{
+*/
+
+static uint16_t last_tick = 0;                                                  ///< Previous tick start cycles counter value
+static uint8_t last_tick_valid = 0;                                             ///< Previous tick start value validity flag
+static uint16_t tick_period_min = U16_MAX;                                      ///< Minimal tick period since the last reset, cycles
+static uint16_t tick_period_max = 0;                                            ///< Maximal tick period since the last reset, cycles
+static uint16_t slot_max[PROFILER_SLOTS_NUMBER];                                ///< Maximal code sections execution times since the last reset, cycles
+
+/**
+@brief Main cycle tick handler
+@details Measures period between the current and the previous tick starts and updates tick period 
+extremums. Tick jitter is the difference between maximal and minimal tick periods.
+@note This function should be called at the beginning of every main cycle iteration
+*/
+void profiler_tick(){
+  uint16_t now = get_cycles_counter();
+  if(last_tick_valid){
+    uint16_t period = now - last_tick;
+    if(period < tick_period_min) tick_period_min = period;
+    if(period > tick_period_max) tick_period_max = period;
+  }
+  last_tick = now;
+  last_tick_valid = 1;
+}
+
+/**
+@brief Tick period measurement restart
+@details Excludes the current tick from tick period measurement. Should be called if the current 
+tick is intentionally long (EEPROM writing, for example).
+*/
+void profiler_restart(){
+  last_tick_valid = 0;
+}
+
+/**
+@brief Code section measurement start
+@return Code section start timestamp, should be passed to profiler_stop()
+*/
+uint16_t profiler_start(){
+  return get_cycles_counter();
+}
+
+/**
+@brief Code section measurement stop
+@details Updates maximal execution time of the code section.
+@param[in] slot Code section slot number (0...PROFILER_SLOTS_NUMBER - 1)
+@param[in] start Code section start timestamp returned by profiler_start()
+*/
+void profiler_stop(uint8_t slot, uint16_t start){
+  uint16_t duration = get_cycles_counter() - start;
+  if(duration > slot_max[slot]) slot_max[slot] = duration;
+}
+
+/**
+@brief Measured values reset
+@details Starts new measurement window. Usually called after measured values were reported.
+*/
+void profiler_reset(){
+  tick_period_min = U16_MAX;
+  tick_period_max = 0;
+  for(uint8_t i = 0; i < PROFILER_SLOTS_NUMBER; ++i){
+    slot_max[i] = 0;
+  }
+}
+
+/**
+@brief Minimal tick period getter
+@return Minimal tick period since the last reset, cycles
+*/
+uint16_t get_tick_period_min(){
+  return tick_period_min;
+}
+
+/**
+@brief Maximal tick period getter
+@return Maximal tick period since the last reset, cycles
+*/
+uint16_t get_tick_period_max(){
+  return tick_period_max;
+}
+
+/**
+@brief Code section execution time getter
+@param[in] slot Code section slot number (0...PROFILER_SLOTS_NUMBER - 1)
+@return Maximal code section execution time since the last reset, cycles
+*/
+uint16_t get_profiler_slot_max(uint8_t slot){
+  return slot_max[slot];
+}
+
+///@}
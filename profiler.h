@@ -0,0 +1,56 @@
+/**
+@file           profiler.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists execution time profiler interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <stm8s.h>
+#include "strip.h"
+
+/**
+@defgroup profiler Profiler
+@brief This module consists main cycle tick period and code sections execution time measurement
+@details All values are measured in MCU cycles using HAL cycles counter.
+@{
+*/
+
+#define PROFILER_SLOT_RGB_HANDLE                0                               ///< Mood lamp logic handler slot
+#define PROFILER_SLOT_PWM_UPDATE                1                               ///< PWM levels batch updating slot
+#define PROFILER_SLOT_OUTPUT                    2                               ///< Output stage slot
+#define PROFILER_SLOT_CORRECTION                3                               ///< Output stage color correction slot
+#define PROFILER_SLOT_STRIP                     4                               ///< Addressable strip frame rendering and sending slot (only if STRIP_ENABLE is set)
+#define PROFILER_SLOTS_NUMBER                   (4 + STRIP_ENABLE)              ///< Profiled code sections quantity
+
+void profiler_tick();
+void profiler_restart();
+uint16_t profiler_start();
+void profiler_stop(uint8_t slot, uint16_t start);
+void profiler_reset();
+uint16_t get_tick_period_min();
+uint16_t get_tick_period_max();
+uint16_t get_profiler_slot_max(uint8_t slot);
+
+///@}
+
+#endif /* __PROFILER_H__ */
@@ -0,0 +1,72 @@
+/**
+@file           protocol.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists serial protocol definitions.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __PROTOCOL_H__
+#define __PROTOCOL_H__
+
+/**
+@defgroup protocol Serial protocol
+@brief This module consists serial link frame format definitions
+@details Every frame has the following format:
+@code
+| 0xA5 | 0x5A | type | length | payload (length bytes) | checksum |
+@endcode
+Checksum is XOR of type, length and payload bytes. Multibyte values are transmitted in big-endian 
+order (as well as they are stored in EEPROM).
+@{
+*/
+
+#define PROTOCOL_SYNC_1                         0xA5                            ///< First frame synchronization byte
+#define PROTOCOL_SYNC_2                         0x5A                            ///< Second frame synchronization byte
+#define PROTOCOL_HEADER_SIZE                    4                               ///< Synchronization bytes, type and length
+#define PROTOCOL_MAX_PAYLOAD_SIZE               36                              ///< Maximal payload length, bytes (telemetry frame with the strip profiler slot)
+#define PROTOCOL_FRAME_OVERHEAD                 (PROTOCOL_HEADER_SIZE + 1)      ///< Header and checksum length, bytes
+
+#define PROTOCOL_TYPE_TELEMETRY                 0x01                            ///< Lamp state and profiler counters (lamp -> host)
+#define PROTOCOL_TYPE_SYNC                      0x02                            ///< Synchronization beacon, see sync.h (leader lamp -> follower lamps)
+#define PROTOCOL_TYPE_SET_COLOR                 0x10                            ///< [Instance number, 1 byte] and destination color {R, G, B}, 3 words (host -> lamp)
+#define PROTOCOL_TYPE_SET_SPEED                 0x11                            ///< Color flow speed: main cycle delay loop iterations (color flow rate in the timer modes), 1 word (host -> lamp)
+#define PROTOCOL_TYPE_FREEZE                    0x12                            ///< [Instance number, 1 byte] and color flow freeze flag, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_PROBABILITIES         0x13                            ///< Color schemes shares, 5 bytes (host -> lamp)
+#define PROTOCOL_TYPE_SET_HOLD                  0x14                            ///< Color hold time in ticks, 1 double word (host -> lamp)
+#define PROTOCOL_TYPE_SAVE_CONFIG               0x15                            ///< Save runtime configuration into EEPROM, no payload (host -> lamp)
+#define PROTOCOL_TYPE_SET_MATRIX                0x16                            ///< Color correction matrix, 9 Q2.14 words row by row (host -> lamp)
+#define PROTOCOL_TYPE_SET_BRIGHTNESS            0x17                            ///< Master brightness, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_INTERPOLATION         0x18                            ///< Interpolation mode, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_EASING                0x19                            ///< Easing curve (RGB_EASING_RANDOM - random for every transition), 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_PACING                0x1A                            ///< Pacing mode, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_SAMPLING              0x1B                            ///< Random destination colors sampling mode, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_DISTANCE              0x1C                            ///< Minimal perceptual distance between new and recent colors, 1 word (host -> lamp)
+#define PROTOCOL_TYPE_SET_PALETTE               0x1D                            ///< Palette of the palette sampling mode, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_SCHEDULER             0x1E                            ///< Main cycle scheduler mode, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_TRIM                  0x1F                            ///< HSI user trimming value (signed), 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_HOLD_MS               0x20                            ///< Color hold time in milliseconds (ignored in the loop scheduler mode), 1 double word (host -> lamp)
+#define PROTOCOL_TYPE_SET_SYNC                  0x21                            ///< Synchronization role, 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_DMX                   0x22                            ///< DMX512 start address (0 - disabled), 2 bytes (host -> lamp)
+#define PROTOCOL_TYPE_SET_STRIP_LAG             0x23                            ///< Addressable strip phase lag (0 - uniform strip), 1 byte (host -> lamp)
+#define PROTOCOL_TYPE_SET_STRIP_PERIOD          0x24                            ///< Addressable strip color history sampling period in color flow steps, 1 word (host -> lamp)
+
+///@}
+
+#endif /* __PROTOCOL_H__ */
@@ -0,0 +1,150 @@
+/**
+@file           regmap.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists I2C register map.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "regmap.h"
+#include "command.h"
+#include "protocol.h"
+#include "mood_logic.h"
+#include "config.h"
+#include "profiler.h"
+#include "hal.h"
+
+#if REGMAP_PROFILER + 2 * PROFILER_SLOTS_NUMBER > HAL_I2C_MAP_SIZE
+ #error "Register map does not fit into I2C register map buffer"
+#endif
+
+/**
+@addtogroup regmap
+@{
+*/
+
+/**
+@brief Writable register
+*/
+typedef struct{
+  uint8_t address;                                                              ///< The first register address
+  uint8_t type;                                                                 ///< Command applying the register value
+  uint8_t length;                                                               ///< Register length, bytes
+}regmap_write_t;
+
+static const regmap_write_t regmap_writes[] = {
+  {REGMAP_FREEZE, PROTOCOL_TYPE_FREEZE, 1},
+  {REGMAP_DESTINATION, PROTOCOL_TYPE_SET_COLOR, 6},
+  {REGMAP_BRIGHTNESS, PROTOCOL_TYPE_SET_BRIGHTNESS, 1},
+  {REGMAP_SCHEDULER, PROTOCOL_TYPE_SET_SCHEDULER, 1},
+  {REGMAP_INTERPOLATION, PROTOCOL_TYPE_SET_INTERPOLATION, 1},
+  {REGMAP_EASING, PROTOCOL_TYPE_SET_EASING, 1},
+  {REGMAP_PACING, PROTOCOL_TYPE_SET_PACING, 1},
+  {REGMAP_SAMPLING, PROTOCOL_TYPE_SET_SAMPLING, 1},
+  {REGMAP_SPEED, PROTOCOL_TYPE_SET_SPEED, 2},
+  {REGMAP_HOLD, PROTOCOL_TYPE_SET_HOLD, 4}
+};                                                                              ///< Writable registers and their commands
+
+static uint16_t regmap_ticks = 0;                                               ///< Tick counter
+static uint8_t regmap_stale = 1;                                                ///< Published registers are out of date
+
+/**
+@brief Big-endian word writer
+@param[out] buffer Destination pointer
+@param[in] value Word to be written
+@return Pointer to the next byte after the written word
+*/
+static uint8_t *put_word(uint8_t *buffer, uint16_t value){
+  *buffer++ = (uint8_t) (value >> 8);
+  *buffer++ = (uint8_t) value;
+  return buffer;
+}
+
+/**
+@brief Written registers applying
+@param[in] address The first written register address
+@param[in] data Pointer to the written data
+@param[in] length Written data length, bytes
+*/
+static void regmap_apply(uint8_t address, const uint8_t *data, uint8_t length){
+  for(uint8_t i = 0; i < sizeof(regmap_writes) / sizeof(regmap_writes[0]); ++i){
+    const regmap_write_t *w = &regmap_writes[i];
+    if(w->address < address) continue;                                          // Register is before the written ones
+    if(w->address + w->length > address + length) continue;                     // Register is not written completely
+    command_execute(w->type, &data[w->address - address], w->length);
+  }
+}
+
+/**
+@brief Registers publishing
+@details Fills the register map back buffer and swaps buffers. If the back buffer is read by the 
+master now, registers stay stale until the next main cycle pass.
+*/
+static void regmap_publish(){
+  uint8_t *p = i2c_map_back();
+  if(!p) return;                                                                // Back buffer is latched by the read transaction
+  *p++ = REGMAP_ID;
+  *p++ = REGMAP_VERSION;
+  p = put_word(p, regmap_ticks);
+  for(uint8_t i = 0; i < 3; ++i){
+    p = put_word(p, get_current_color(&mood_engines[0], i));
+  }
+  *p++ = get_color_scheme(&mood_engines[0]);
+  *p++ = mood_engines[0].frozen;
+  for(uint8_t i = 0; i < 3; ++i){
+    p = put_word(p, get_destination_color(&mood_engines[0], i));
+  }
+  *p++ = mood_config.brightness;
+  *p++ = mood_config.scheduler;
+  *p++ = mood_config.interpolation;
+  *p++ = mood_config.easing;
+  *p++ = mood_config.pacing;
+  *p++ = mood_config.sampling;
+  p = put_word(p, mood_config.color_flow_delay);
+  p = put_word(p, (uint16_t) (mood_config.color_hold_ticks >> 16));
+  p = put_word(p, (uint16_t) mood_config.color_hold_ticks);
+  p = put_word(p, get_tick_period_min());
+  p = put_word(p, get_tick_period_max());
+  for(uint8_t i = 0; i < PROFILER_SLOTS_NUMBER; ++i){
+    p = put_word(p, get_profiler_slot_max(i));
+  }
+  i2c_map_swap();
+  regmap_stale = 0;
+}
+
+/**
+@brief Register map handler
+@details Applies the write transaction received by I2C and republishes registers if they could be 
+changed.
+@param[in] ticks Ticks elapsed since the previous call
+@note This function should be called once per main cycle pass, after mood lamp logic handling
+*/
+void regmap_handle(uint16_t ticks){
+  uint8_t data[HAL_I2C_WRITE_SIZE];
+  uint8_t address;
+  uint8_t length = i2c_write_get(&address, data);
+  if(length) regmap_apply(address, data, length);
+  regmap_ticks += ticks;
+  if(ticks || length) regmap_stale = 1;
+  if(regmap_stale) regmap_publish();
+}
+
+///@}
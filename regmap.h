@@ -0,0 +1,84 @@
+/**
+@file           regmap.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists I2C register map headers.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef __REGMAP_H__
+#define __REGMAP_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup regmap Register map
+@brief This module consists I2C register map for the host MCU control
+@details The host MCU reads and writes the lamp state as I2C slave registers (see @ref hal_i2c). 
+Multibyte values are big-endian, R - read-only, RW - readable and writable:
+@code
+address  size  access  value
+0x00     1     R       REGMAP_ID
+0x01     1     R       REGMAP_VERSION
+0x02     2     R       Tick counter (wraps around)
+0x04     6     R       Current color {R, G, B}
+0x0A     1     R       Color scheme
+0x0B     1     RW      Color flow freeze flag
+0x0C     6     RW      Destination color {R, G, B}
+0x12     1     RW      Master brightness
+0x13     1     RW      Scheduler mode
+0x14     1     RW      Interpolation mode
+0x15     1     RW      Easing curve
+0x16     1     RW      Pacing mode
+0x17     1     RW      Sampling mode
+0x18     2     RW      Main cycle delay loop iterations
+0x1A     4     RW      Color hold time, ticks
+0x1E     2     R       Minimal tick period, cycles
+0x20     2     R       Maximal tick period, cycles
+0x22     2*N   R       Profiler slots maximal execution times, cycles
+@endcode
+Colors and freeze flag are the first mood lamp logic instance ones. Written registers are applied 
+as the serial commands of the same meaning (see command_execute()), so they are validated the same 
+way, invalid values are ignored. One write transaction may set several adjacent registers, 
+partially written registers are ignored. Registers are republished by the main cycle pass which 
+handles ticks or applies a write.
+@{
+*/
+
+#define REGMAP_ID                               0x4D                            ///< Register map signature
+#define REGMAP_VERSION                          1                               ///< Register map format version
+#define REGMAP_FREEZE                           0x0B                            ///< Color flow freeze flag register
+#define REGMAP_DESTINATION                      0x0C                            ///< Destination color registers
+#define REGMAP_BRIGHTNESS                       0x12                            ///< Master brightness register
+#define REGMAP_SCHEDULER                        0x13                            ///< Scheduler mode register
+#define REGMAP_INTERPOLATION                    0x14                            ///< Interpolation mode register
+#define REGMAP_EASING                           0x15                            ///< Easing curve register
+#define REGMAP_PACING                           0x16                            ///< Pacing mode register
+#define REGMAP_SAMPLING                         0x17                            ///< Sampling mode register
+#define REGMAP_SPEED                            0x18                            ///< Main cycle delay loop iterations registers
+#define REGMAP_HOLD                             0x1A                            ///< Color hold time registers
+#define REGMAP_PROFILER                         0x22                            ///< The first profiler slot registers
+
+void regmap_handle(uint16_t ticks);
+
+///@}
+
+#endif /* __REGMAP_H__ */
@@ -0,0 +1,223 @@
+/**
+@file           scheduler.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists main cycle scheduler.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "scheduler.h"
+#include "hal.h"
+#include "config.h"
+#include "mood_logic.h"
+#include "output.h"
+#include "strip.h"
+#include "profiler.h"
+
+/**
+@addtogroup scheduler
+@{
+*/
+
+static uint16_t scheduler_wakeups = 0;                                          ///< Main cycle passes since the last wakeups reading
+static uint16_t scheduler_rx_grace = 0;                                         ///< Remaining ticks of the wait mode sleeping after incoming data
+static uint8_t scheduler_mode = SCHEDULER_MODES_NUMBER;                         ///< Scheduler mode of the tick timer state (none before the first pass)
+static uint16_t scheduler_delay = RGB_COLOR_FLOW_DELAY;                         ///< Color flow speed of the current color flow rate
+static uint16_t scheduler_rate = SCHEDULER_RATE_ONE;                            ///< Color flow rate of the timer modes, 1/256 steps per tick
+static uint8_t scheduler_fraction = 0;                                          ///< Color flow steps fractional part, 1/256 steps
+
+/**
+@brief Color flow rate updating
+@details Recalculates the color flow rate if the color flow speed was changed, so the division is 
+made only once per change.
+*/
+static void scheduler_update_rate(){
+  uint32_t rate = SCHEDULER_RATE_MAX;
+  if(mood_config.color_flow_delay == scheduler_delay) return;
+  scheduler_delay = mood_config.color_flow_delay;
+  if(scheduler_delay){
+    rate = (((uint32_t) RGB_COLOR_FLOW_DELAY) * SCHEDULER_RATE_ONE) / scheduler_delay;
+  }
+  if(rate > SCHEDULER_RATE_MAX) rate = SCHEDULER_RATE_MAX;
+  if(!rate) rate = 1;
+  scheduler_rate = (uint16_t) rate;
+}
+
+/**
+@brief Color flow steps to ticks conversion
+@param[in] steps Color flow steps (not zero)
+@return Ticks which make the specified steps at the current color flow rate (not zero)
+*/
+static uint16_t scheduler_steps_to_ticks(uint16_t steps){
+  uint32_t ticks;
+  if(scheduler_rate == SCHEDULER_RATE_ONE) return steps;
+  ticks = ((((uint32_t) steps) << 8) - scheduler_fraction + scheduler_rate - 1) / scheduler_rate;
+  return (ticks > SCHEDULER_MAX_SLEEP) ? SCHEDULER_MAX_SLEEP : (uint16_t) ticks;
+}
+
+/**
+@brief Tickless sleep time calculation
+@return Ticks to the nearest output change of all mood lamp logic instances and the addressable 
+strip
+*/
+static uint16_t scheduler_sleep_ticks(){
+  uint16_t ticks = SCHEDULER_MAX_SLEEP;
+  uint16_t strip_ticks = strip_ticks_to_change();
+  uint16_t strip_steps = strip_steps_to_change();
+  if(dmx_is_active()) return ticks;                                             // Main cycle is woken by DMX512 frames
+  if(!output_is_settled()) return 1;                                            // Output stage ramp changes levels every tick
+  if(strip_ticks < ticks) ticks = strip_ticks;                                  // Strip frame sending
+  if(strip_steps != U16_MAX) strip_ticks = scheduler_steps_to_ticks(strip_steps);
+  if(strip_ticks < ticks) ticks = strip_ticks;                                  // Traveling wave sampling
+  for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){
+    uint16_t engine_ticks = scheduler_steps_to_ticks(rgb_ticks_to_change(&mood_engines[i]));
+    if(engine_ticks < ticks) ticks = engine_ticks;
+  }
+  return ticks;
+}
+
+/**
+@brief Wait mode sleeping
+@details Long sleep is made with the slow CPU clock (see clk_cpu_slow()), the CPU is woken only by 
+interrupts during it.
+@param[in] sleep Ticks to be elapsed since the previous waiting
+@return Ticks elapsed since the previous waiting
+*/
+static uint16_t scheduler_sleep(uint16_t sleep){
+  uint16_t ticks;
+  if((sleep < SCHEDULER_SLOW_SLEEP) || dmx_is_active()){                        // DMX512 receiver needs the full CPU clock
+    return tick_wait(sleep);
+  }
+  clk_cpu_slow(1);
+  ticks = tick_wait(sleep);
+  clk_cpu_slow(0);
+  return ticks;
+}
+
+/**
+@brief Active-halt sleeping
+@details Sleeps in the active-halt mode if PWM outputs are static and the sleep is long enough, 
+otherwise sleeps in the wait mode (PWM timers keep running). Telemetry transmission is finished 
+before halting. Incoming data (active-halt interruption, main cycle wakeup before the deadline or 
+received data waiting for handling) starts SCHEDULER_RX_GRACE ticks of the wait mode sleeping, so 
+the bytes following the wake-up byte are received by UART.
+@param[in] sleep Ticks to the nearest output change
+@return Ticks elapsed since the previous waiting
+*/
+static uint16_t scheduler_halt(uint16_t sleep){
+  uint16_t ticks;
+  if(uart_rx_pending() || i2c_write_pending()) scheduler_rx_grace = SCHEDULER_RX_GRACE;
+  if(scheduler_rx_grace || (sleep < HAL_AWU_TICKS) || !pwm_is_static() ||\
+    dmx_is_active()){                                                           // Wait mode keeps PWM and UART running
+    if(scheduler_rx_grace && (sleep > scheduler_rx_grace)) sleep = scheduler_rx_grace;
+    ticks = scheduler_sleep(sleep);
+    if(ticks < sleep){                                                          // Woken by incoming data
+      scheduler_rx_grace = SCHEDULER_RX_GRACE;
+    }else{
+      scheduler_rx_grace = (scheduler_rx_grace > ticks) ? scheduler_rx_grace - ticks : 0;
+    }
+    return ticks;
+  }
+  if(!uart_tx_idle() || i2c_is_busy()) return tick_wait(1);                     // Telemetry frame is still being sent or I2C transaction is in progress
+  pwm_force_static(1);
+  ticks = awu_halt(sleep);
+  pwm_force_static(0);
+  if(awu_is_interrupted()) scheduler_rx_grace = SCHEDULER_RX_GRACE;             // The rest of the command follows the wake-up byte
+  return ticks + tick_wait(0);                                                  // Ticks counted by the tick timer before halting
+}
+
+/**
+@brief Main cycle waiting
+@details Waits according to the runtime configured scheduler mode. Long sleep is excluded from 
+tick period measurement. Tick timer is restarted on every scheduler mode change, so the first 
+pass of a timer mode counts only the ticks elapsed since the change.
+@return Ticks elapsed since the previous call (0 if the main cycle was woken by received data 
+before the first tick)
+@note This function should be called once per main cycle pass, before mood lamp logic handling
+*/
+uint16_t scheduler_wait(){
+  uint16_t ticks;
+  if(scheduler_wakeups < U16_MAX) ++scheduler_wakeups;
+  scheduler_update_rate();
+  if(mood_config.scheduler != scheduler_mode){                                  // Tick timer runs only in the timer modes
+    scheduler_mode = mood_config.scheduler;
+    tick_run(scheduler_mode != SCHEDULER_LOOP);                                 // Ticks counted in the previous mode are dropped
+  }
+  if(mood_config.scheduler == SCHEDULER_LOOP){
+    uint16_t delay = mood_config.color_flow_delay;
+    for(uint16_t i = 0; i < delay; ++i);                                        // Color flow speed regulation
+    return 1;
+  }
+  if(mood_config.scheduler == SCHEDULER_TIMER){
+    ticks = tick_wait(1);
+  }else if(mood_config.scheduler == SCHEDULER_TICKLESS){
+    ticks = scheduler_sleep(scheduler_sleep_ticks());
+  }else{
+    ticks = scheduler_halt(scheduler_sleep_ticks());
+  }
+  if(ticks > 1) profiler_restart();
+  return ticks;
+}
+
+/**
+@brief Elapsed ticks to color flow steps conversion
+@details Loop mode tick is one step (the delay loop regulates the color flow speed). Timer modes 
+ticks are multiplied by the color flow rate, the fractional part is kept for the next call.
+@param[in] ticks Ticks elapsed since the previous call
+@return Color flow steps to be made
+@note This function should be called once per main cycle pass with the ticks returned by 
+scheduler_wait()
+*/
+uint16_t scheduler_steps(uint16_t ticks){
+  uint32_t steps;
+  if(mood_config.scheduler == SCHEDULER_LOOP) return ticks;
+  steps = ((uint32_t) ticks) * scheduler_rate + scheduler_fraction;
+  scheduler_fraction = (uint8_t) steps;
+  steps >>= 8;
+  return (steps > U16_MAX) ? U16_MAX : (uint16_t) steps;
+}
+
+/**
+@brief Milliseconds to color flow steps conversion
+@details Converts the time into timer modes ticks and multiplies them by the current color flow 
+rate, so the hold set in milliseconds lasts the specified time at the current color flow speed.
+@param[in] ms Time, milliseconds (no more than SCHEDULER_MAX_HOLD_MS)
+@return Color flow steps
+@note Loop mode tick duration depends on the main cycle execution time, so the result is valid 
+only in the timer modes
+*/
+uint32_t scheduler_ms_to_steps(uint32_t ms){
+  uint32_t ticks = SCHEDULER_MS_TO_TICKS(ms);
+  scheduler_update_rate();
+  return (ticks >> 8) * scheduler_rate + (((ticks & 0xFF) * scheduler_rate) >> 8);
+}
+
+/**
+@brief CPU wakeups counter getter
+@details Returns and resets the sum of main cycle passes and tick timer interrupts.
+@return CPU wakeups since the previous call (saturated at U16_MAX)
+*/
+uint16_t get_scheduler_wakeups(){
+  uint32_t wakeups = ((uint32_t) scheduler_wakeups) + get_tick_interrupts();
+  scheduler_wakeups = 0;
+  return (wakeups > U16_MAX) ? U16_MAX : (uint16_t) wakeups;
+}
+
+///@}
@@ -0,0 +1,91 @@
+/**
+@file           scheduler.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists main cycle scheduler headers.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include <stm8s.h>
+#include "hal.h"
+
+/**
+@defgroup scheduler Scheduler
+@brief This module consists main cycle timing
+@details Scheduler decides how long the main cycle waits before the next pass. Modes are:
+-# SCHEDULER_LOOP: legacy busy delay loop of the runtime configured length, every pass is one 
+tick. Tick period depends on the main cycle execution time;
+-# SCHEDULER_TIMER: the CPU sleeps (wait mode) until the next tick of the HAL tick timer, every 
+pass is one tick of the fixed period;
+-# SCHEDULER_TICKLESS: the CPU sleeps until the nearest tick which changes PWM levels (see 
+rgb_ticks_to_change()), mood lamp logic skips the elapsed ticks at once. While output stage ramps 
+are active, the main cycle passes every tick. Sleep time is limited by SCHEDULER_MAX_SLEEP, so 
+telemetry is still reported during long unchanged periods;
+-# SCHEDULER_HALT: tickless mode which sleeps in the active-halt mode when all PWM outputs are 
+static (every channel is turned off or fully turned on, for example during the hold of the color 
+schemes primaries and pseudowhite). Only LSI and AWU are running, the CPU is woken every 
+HAL_AWU_TICKS ticks. Other sleeps are made in the wait mode, because PWM timers can not run 
+without the main clock. The first command byte received during the active-halt mode is lost 
+(see @ref hal_awu), after incoming data the CPU sleeps only in the wait mode until the line is 
+silent for SCHEDULER_RX_GRACE ticks, so the following bytes are received.
+
+Color flow speed (delay loop iterations of the loop mode) is applied in the timer modes as the 
+color flow rate: RGB_COLOR_FLOW_DELAY iterations are one color flow step per tick, the rate is 
+inversely proportional to the iterations (1/256 step resolution, no more than SCHEDULER_RATE_MAX), 
+so the flow speed of the loop mode is kept with the main cycle execution time neglected. Mood lamp 
+logic, color hold and synchronization count color flow steps, at the default speed a step is one 
+tick. Elapsed ticks are converted into steps by scheduler_steps().
+
+Timer modes ticks are HAL tick timer periods of 128us (8 ticks are exactly 1.024ms), so durations 
+set in milliseconds have the HSI accuracy (see @ref hal_clk). Loop mode tick period depends on the 
+main cycle execution time, so durations can not be set in milliseconds in the loop mode (see 
+scheduler_ms_to_steps()).
+
+Tickless sleeps of SCHEDULER_SLOW_SLEEP ticks and longer are made with the slow CPU clock (PWM 
+timers clocking is not changed). Received UART byte always wakes the main cycle. CPU wakeups (main cycle passes, tick timer and AWU 
+interrupts) are counted for telemetry.
+@{
+*/
+
+#define SCHEDULER_LOOP                          0                               ///< Busy delay loop mode
+#define SCHEDULER_TIMER                         1                               ///< Tick timer mode
+#define SCHEDULER_TICKLESS                      2                               ///< Sleep until the next output change mode
+#define SCHEDULER_HALT                          3                               ///< Tickless mode with active-halt sleeping
+#define SCHEDULER_MODES_NUMBER                  4                               ///< Scheduler modes quantity
+#define SCHEDULER_MODE                          SCHEDULER_LOOP                  ///< Default scheduler mode
+#define SCHEDULER_MAX_SLEEP                     8192                            ///< Maximal tickless sleep time, ticks (~1s)
+#define SCHEDULER_MS_TO_TICKS(MS)               (((uint32_t) (MS) * 125) >> 4)  ///< Milliseconds to ticks conversion (128us tick of timer modes)
+#define SCHEDULER_MAX_HOLD_MS                   (U32_MAX / 125)                 ///< Maximal color hold time, milliseconds
+#define SCHEDULER_RX_GRACE                      80                              ///< Wait mode sleeping after incoming data in the active-halt mode, ticks (~10ms, 115 bytes at 115200 baud)
+#define SCHEDULER_SLOW_SLEEP                    HAL_TICK_CHUNK_MAX              ///< Minimal tickless sleep time with the slow CPU clock, ticks
+#define SCHEDULER_RATE_ONE                      256                             ///< Color flow rate of one step per tick, 1/256 steps per tick
+#define SCHEDULER_RATE_MAX                      (8 * SCHEDULER_RATE_ONE)        ///< Maximal color flow rate, 1/256 steps per tick
+
+uint16_t scheduler_wait();
+uint16_t scheduler_steps(uint16_t ticks);
+uint32_t scheduler_ms_to_steps(uint32_t ms);
+uint16_t get_scheduler_wakeups();
+
+///@}
+
+#endif /* __SCHEDULER_H__ */
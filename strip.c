@@ -0,0 +1,210 @@
+/**
+@file           strip.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists addressable LED strip output.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "strip.h"
+#include "output.h"
+#include "config.h"
+#include "profiler.h"
+#include "hal.h"
+
+#if STRIP_ENABLE && (STRIP_FRAME_TICKS * 128 <= HAL_SPI_RESET_US)
+ #error "Strip frame period is shorter than the LEDs reset time"
+#endif
+
+#if STRIP_ENABLE && (STRIP_PIXELS > STRIP_PIXELS_MAX)
+ #error "Strip is too long for the blocking frame sending"
+#endif
+
+#if STRIP_ENABLE && (STRIP_GROUPS < 2)
+ #error "Strip must have at least 2 pixel groups"
+#endif
+
+/**
+@addtogroup strip
+@{
+*/
+
+#if STRIP_ENABLE
+static uint8_t strip_frame[3 * STRIP_PIXELS];                                   ///< Frame buffer
+static uint8_t strip_ready = 0;                                                 ///< Frame is rendered and is not sent yet
+static uint16_t strip_ticks = STRIP_FRAME_TICKS;                                ///< Ticks since the previous frame sending
+static uint8_t strip_color[3];                                                  ///< The last sampled color in the LEDs order
+static uint8_t strip_history[STRIP_HISTORY][3];                                 ///< Color history ring in the LEDs order
+static uint8_t strip_head = 0;                                                  ///< The newest history sample
+static uint16_t strip_history_steps = 0;                                        ///< Color flow steps since the previous history sampling
+static uint8_t strip_history_changed = 0;                                       ///< Color was changed since the previous history sampling
+static uint8_t strip_unchanged = 0;                                             ///< Consecutive history samples equal to the previous ones
+static uint8_t strip_lag = STRIP_LAG;                                           ///< Phase lag of the rendered frames
+
+/**
+@brief Current color sampling
+@details Output levels are linear, so 8-bit LEDs PWM takes their high bytes.
+@return 1 if the color was changed since the previous sampling, 0 otherwise
+*/
+static uint8_t strip_sample(){
+  uint8_t color[3];
+  uint8_t changed = 0;
+  color[STRIP_GRB ? 1 : 0] = (uint8_t) (get_output_level(0) >> 8);
+  color[STRIP_GRB ? 0 : 1] = (uint8_t) (get_output_level(1) >> 8);
+  color[2] = (uint8_t) (get_output_level(2) >> 8);
+  for(uint8_t i = 0; i < 3; ++i){
+    if(color[i] != strip_color[i]) changed = 1;
+    strip_color[i] = color[i];
+  }
+  return changed;
+}
+
+/**
+@brief Uniform frame rendering
+@details Fills the frame buffer by the current color.
+*/
+static void strip_render_uniform(){
+  uint8_t *p = strip_frame;
+  for(uint8_t i = 0; i < STRIP_PIXELS; ++i){
+    *p++ = strip_color[0];
+    *p++ = strip_color[1];
+    *p++ = strip_color[2];
+  }
+  strip_ready = 1;
+}
+
+/**
+@brief Traveling wave frame rendering
+@details Fills the frame buffer by the history samples, every next pixel group shows the sample 
+taken strip_lag samples earlier.
+*/
+static void strip_render_wave(){
+  uint8_t *p = strip_frame;
+  uint8_t sample = strip_head;
+  for(uint8_t i = 0, group = 0; i < STRIP_PIXELS; ++i){
+    const uint8_t *color = strip_history[sample];
+    *p++ = color[0];
+    *p++ = color[1];
+    *p++ = color[2];
+    if(++group == STRIP_GROUP_PIXELS){
+      group = 0;
+      sample = (sample - strip_lag) & (STRIP_HISTORY - 1);
+    }
+  }
+  strip_ready = 1;
+}
+
+/**
+@brief Color history sampling
+@details Puts the current color into the history ring and renders the wave frame while the strip 
+shows different samples.
+*/
+static void strip_history_handle(){
+  uint8_t span = (STRIP_GROUPS - 1) * strip_lag;                                // Samples shown by the strip at once
+  strip_head = (strip_head + 1) & (STRIP_HISTORY - 1);
+  for(uint8_t i = 0; i < 3; ++i){
+    strip_history[strip_head][i] = strip_color[i];
+  }
+  if(strip_history_changed){
+    strip_unchanged = 0;
+  }else if(strip_unchanged <= span){
+    ++strip_unchanged;
+  }
+  strip_history_changed = 0;
+  if(strip_lag && (strip_unchanged <= span)) strip_render_wave();               // The oldest shown sample differs from the newest one
+}
+#endif
+
+/**
+@brief Addressable strip initialization
+*/
+void strip_init(){
+#if STRIP_ENABLE
+  spi_init();
+#endif
+}
+
+/**
+@brief Addressable strip handler
+@details Samples the current color, renders the frame if it was changed and sends the rendered 
+frame if the frame period is elapsed since the previous sending. Color history is sampled once per 
+the runtime configured number of color flow steps. Frame rendered during the period 
+replaces the previous one, so only the newest frame is sent.
+@param[in] ticks Ticks elapsed since the previous call
+@param[in] steps Color flow steps made since the previous call
+@note This function should be called once per main cycle pass after the output stage
+*/
+void strip_handle(uint16_t ticks, uint16_t steps){
+#if STRIP_ENABLE
+  uint16_t timestamp = profiler_start();
+  uint8_t changed = strip_sample();
+  strip_ticks = (ticks < STRIP_FRAME_TICKS - strip_ticks) ? strip_ticks + ticks : STRIP_FRAME_TICKS;
+  strip_history_steps = (steps < mood_config.strip_period - strip_history_steps) ?\
+    strip_history_steps + steps : mood_config.strip_period;
+  strip_history_changed |= changed;
+  if(strip_lag != mood_config.strip_lag){                                       // Phase lag is applied at once
+    strip_lag = mood_config.strip_lag;
+    strip_history_changed = 1;
+    changed = 1;
+  }
+  if(strip_history_steps >= mood_config.strip_period){                          // Period can be shortened by command
+    strip_history_steps = 0;
+    strip_history_handle();
+  }
+  if(!strip_lag && changed) strip_render_uniform();
+  if(strip_ready && (strip_ticks == STRIP_FRAME_TICKS)){
+    spi_send_pixels(strip_frame, sizeof(strip_frame));
+    strip_ready = 0;
+    strip_ticks = 0;
+  }
+  profiler_stop(PROFILER_SLOT_STRIP, timestamp);
+#else
+  (void) ticks;
+  (void) steps;
+#endif
+}
+
+/**
+@brief Strip sleep time calculation
+@return Ticks to the rendered frame sending, U16_MAX if there is no frame to be sent
+*/
+uint16_t strip_ticks_to_change(){
+#if STRIP_ENABLE
+  if(strip_ready) return STRIP_FRAME_TICKS - strip_ticks;                       // Frame period is not elapsed yet
+#endif
+  return U16_MAX;
+}
+
+/**
+@brief Strip sampling time calculation
+@return Color flow steps to the history sampling while the wave travels, U16_MAX if the strip 
+does not need sampling
+*/
+uint16_t strip_steps_to_change(){
+#if STRIP_ENABLE
+  if(strip_lag && (strip_unchanged <= (STRIP_GROUPS - 1) * strip_lag)){
+    return (strip_history_steps < mood_config.strip_period) ? mood_config.strip_period - strip_history_steps : 1;
+  }
+#endif
+  return U16_MAX;
+}
+
+///@}
@@ -0,0 +1,86 @@
+/**
+@file           strip.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists addressable LED strip output headers.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef __STRIP_H__
+#define __STRIP_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup strip Addressable strip
+@brief This module consists addressable LED strip output backend
+@details The second output backend renders STRIP_PIXELS pixels of WS2812-class LEDs connected to 
+SPI MOSI pin (see @ref hal_spi). The strip shows the color of the first mood lamp logic instance 
+after the output stage (linearization, master brightness, color correction and power limitation), 
+PWM outputs keep working. Frame is rendered into one buffer when the color changes and is sent 
+no more often than once per STRIP_FRAME_TICKS ticks, so the LEDs reset time is always kept. 
+Rendering and sending are both made by the main cycle, so the frame is never sent half rendered, 
+and sending blocks the main cycle for the frame wire time (see @ref hal_spi). Frame rendering and 
+sending time is measured by the profiler (PROFILER_SLOT_STRIP). Strip length is limited by 
+STRIP_PIXELS_MAX: the frame wire time takes at most a half of the 16-bit profiler cycles range 
+(the rest is left for rendering), so the measurement never wraps, and the main cycle is delayed 
+by no more than 16 ticks (elapsed ticks are still counted by the scheduler).
+
+Pixels are joined into groups of STRIP_GROUP_PIXELS pixels. If the runtime configured phase lag 
+is 0, all groups show the current color. Otherwise the color trajectory is sampled into the 
+history ring every runtime configured sampling period and the group number N shows the sample 
+taken N * lag samples ago, so color waves travel from the first pixel to the end of the strip. Only 
+one color per sample is calculated, pixels are just copied from the ring, so the rendering cost is 
+proportional to the strip length only in bytes copying. The whole strip delay is limited by the 
+ring length: (STRIP_GROUPS - 1) * lag < STRIP_HISTORY samples. Short strips take a small lag 
+(2 samples for 30 pixels), so the wave length is set by the sampling period. The period is 
+counted in color flow steps (see scheduler_steps()), so the wave covers the same part of the color 
+trajectory at every color flow speed and in every scheduler mode: the default period is ~131ms at 
+the default speed of the timer modes and the whole strip delay is ~8.4s at most. When the color 
+stops changing, frames are rendered until the wave leaves the strip.
+
+Frame period is counted in ticks: ~10ms in the timer modes. In the loop scheduler mode a tick is 
+one main cycle pass, so the period depends on the main cycle execution time (see @ref scheduler), 
+it is still longer than the LEDs reset time, because every pass is longer than 1us.
+@{
+*/
+
+#define STRIP_ENABLE                            0                               ///< Addressable strip usage: 1 - strip is connected to PC6, 0 - strip is not used
+#define STRIP_PIXELS                            30                              ///< Strip pixels quantity (up to STRIP_PIXELS_MAX)
+#define STRIP_PIXELS_MAX                        ((U16_MAX / 2) / HAL_SPI_PIXEL_CYCLES) ///< Maximal strip pixels quantity (85, ~2ms of blocking sending)
+#define STRIP_GRB                               1                               ///< Pixel data order: 1 - GRB (WS2812, SK6812), 0 - RGB
+#define STRIP_FRAME_TICKS                       80                              ///< Minimal frame period, ticks (~10ms in the timer modes, it is longer than the LEDs reset time)
+#define STRIP_GROUP_PIXELS                      1                               ///< Pixels quantity of the group showing the same color
+#define STRIP_GROUPS                            ((STRIP_PIXELS + STRIP_GROUP_PIXELS - 1) / STRIP_GROUP_PIXELS) ///< Pixel groups quantity (at least 2)
+#define STRIP_HISTORY                           64                              ///< Color history ring length, samples, must be a power of two
+#define STRIP_PERIOD                            1024                            ///< Default color history sampling period, color flow steps (~131ms at the default speed)
+#define STRIP_PERIOD_MIN                        16                              ///< Minimal color history sampling period, color flow steps
+#define STRIP_LAG                               0                               ///< Default phase lag between adjacent pixel groups, samples (0 - all pixels show the current color)
+#define STRIP_LAG_MAX                           ((STRIP_HISTORY - 1) / (STRIP_GROUPS - 1)) ///< Maximal phase lag, samples
+
+void strip_init();
+void strip_handle(uint16_t ticks, uint16_t steps);
+uint16_t strip_ticks_to_change();
+uint16_t strip_steps_to_change();
+
+///@}
+
+#endif /* __STRIP_H__ */
@@ -0,0 +1,178 @@
+/**
+@file           sync.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists multi-lamp synchronization.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "sync.h"
+#include "protocol.h"
+#include "mood_logic.h"
+#include "config.h"
+#include "xorshift.h"
+#include "hal.h"
+
+/**
+@addtogroup sync
+@{
+*/
+
+static uint16_t sync_seed;                                                      ///< Random number generator seed of the current instances
+static uint32_t sync_epoch = 0;                                                 ///< Ticks handled by instances since their initialization by the seed
+static uint16_t sync_beacon_ticks = 0;                                          ///< Ticks since the last beacon sending
+static uint8_t sync_locked = 0;                                                 ///< Follower instances were initialized by the leader seed
+static uint8_t sync_received = 0;                                               ///< Beacon was received and is not handled yet
+static uint16_t sync_received_seed;                                             ///< Received beacon seed
+static uint32_t sync_received_epoch;                                            ///< Received beacon ticks
+static uint32_t sync_catchup = 0;                                               ///< Ticks to be advanced to catch up with the leader
+static uint16_t sync_pause = 0;                                                 ///< Ticks to be paused to wait for the leader
+
+/**
+@brief Beacon sending
+@details Puts the beacon frame into UART transmitter buffer, frame is dropped if there is not 
+enough space in the buffer.
+*/
+static void sync_send(){
+  uint8_t frame[SYNC_BEACON_SIZE + PROTOCOL_FRAME_OVERHEAD];
+  uint8_t checksum = 0;
+  frame[0] = PROTOCOL_SYNC_1;
+  frame[1] = PROTOCOL_SYNC_2;
+  frame[2] = PROTOCOL_TYPE_SYNC;
+  frame[3] = SYNC_BEACON_SIZE;
+  frame[4] = (uint8_t) (sync_seed >> 8);
+  frame[5] = (uint8_t) sync_seed;
+  for(uint8_t i = 0; i < 4; ++i){
+    frame[6 + i] = (uint8_t) (sync_epoch >> (24 - 8 * i));
+  }
+  for(uint8_t i = 2; i < sizeof(frame) - 1; ++i){                               // Checksum covers type, length and payload
+    checksum ^= frame[i];
+  }
+  frame[sizeof(frame) - 1] = checksum;
+  (void) uart_write(frame, sizeof(frame));
+}
+
+/**
+@brief Received beacon following
+@details Restarts instances from the beacon seed if it is needed and corrects the phase error. 
+The leader handles the beacon ticks in the same main cycle pass when the beacon is sent, so the 
+follower compares it with the ticks handled at the end of the current pass.
+@param[in] ticks Ticks of the current main cycle pass
+*/
+static void sync_follow(uint16_t ticks){
+  uint32_t target = sync_received_epoch + SYNC_LATENCY_TICKS;
+  int32_t error = (int32_t) (target - (sync_epoch + sync_catchup - sync_pause + ticks));
+  if(!sync_locked || (sync_received_seed != sync_seed) || (error > SYNC_RESYNC_TICKS) ||\
+    (error < -SYNC_RESYNC_TICKS)){                                              // Restart from the leader seed
+    sync_seed = sync_received_seed;
+    uint16_xorshift_init(sync_seed);
+    for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){
+      mood_engine_init(&mood_engines[i], mood_engines[i].first_channel, mood_engines[i].white_channel);
+    }
+    sync_epoch = 0;
+    sync_catchup = 0;
+    sync_pause = 0;
+    sync_locked = 1;
+    error = (int32_t) (target - ticks);
+  }
+  if(error > 0){                                                                // Follower is behind the leader
+    if(sync_pause >= error){
+      sync_pause -= (uint16_t) error;
+    }else{
+      sync_catchup += (uint32_t) error - sync_pause;
+      sync_pause = 0;
+    }
+  }else if(error < 0){                                                          // Follower is ahead of the leader
+    error = -error;
+    if(sync_catchup >= (uint32_t) error){
+      sync_catchup -= error;
+    }else{
+      sync_pause += (uint16_t) (error - sync_catchup);
+      sync_catchup = 0;
+    }
+  }
+}
+
+/**
+@brief Synchronization initialization
+@details Takes the seed of the mood lamp logic instances from the random number generator.
+@note This function should be called before mood lamp logic instances initialization
+*/
+void sync_init(){
+  sync_seed = get_random_uint16();                                              // Generator state is the returned value itself
+}
+
+/**
+@brief Received beacon handler
+@details Stores the beacon, it is handled by the next sync_handle() call. Beacons are ignored if 
+the lamp is not a follower.
+@param[in] payload Beacon frame payload (SYNC_BEACON_SIZE bytes)
+*/
+void sync_beacon(const uint8_t *payload){
+  if(mood_config.sync_role != SYNC_FOLLOWER) return;
+  sync_received_seed = (((uint16_t) payload[0]) << 8) | payload[1];
+  sync_received_epoch = 0;
+  for(uint8_t i = 2; i < SYNC_BEACON_SIZE; ++i){
+    sync_received_epoch = (sync_received_epoch << 8) | payload[i];
+  }
+  sync_received = 1;
+}
+
+/**
+@brief Synchronization handler
+@details Leader counts ticks and sends beacons. Follower handles the received beacon, advances 
+instances by a part of catching up ticks and pauses them if it is needed.
+@param[in] ticks Ticks elapsed since the previous call
+@return Ticks to be handled by mood lamp logic instances
+@note This function should be called once per main cycle pass after received commands handling 
+and before mood lamp logic handling
+*/
+uint16_t sync_handle(uint16_t ticks){
+  if(mood_config.sync_role == SYNC_FOLLOWER){
+    if(sync_received){
+      sync_received = 0;
+      sync_follow(ticks);
+    }
+    if(sync_catchup){
+      uint32_t advance = (sync_catchup > SYNC_CATCHUP_TICKS) ? SYNC_CATCHUP_TICKS : sync_catchup;
+      rgb_advance(advance);                                                     // All instances, interleaved
+      sync_epoch += advance;
+      sync_catchup -= advance;
+    }
+    if(sync_pause){
+      uint16_t pause = (sync_pause > ticks) ? ticks : sync_pause;
+      sync_pause -= pause;
+      ticks -= pause;
+    }
+  }else{
+    sync_locked = 0;                                                            // The next following starts from the leader seed
+  }
+  sync_epoch += ticks;
+  if(mood_config.sync_role == SYNC_LEADER){
+    sync_beacon_ticks += ticks;
+    if(sync_beacon_ticks >= SYNC_PERIOD){
+      sync_beacon_ticks = 0;
+      sync_send();
+    }
+  }
+  return ticks;
+}
+
+///@}
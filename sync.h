@@ -0,0 +1,76 @@
+/**
+@file           sync.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists multi-lamp synchronization headers.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __SYNC_H__
+#define __SYNC_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup sync Synchronization
+@brief This module consists multi-lamp lockstep synchronization
+@details Several lamps share one serial line: the leader lamp TX is connected to RX of all follower 
+lamps. Every SYNC_PERIOD ticks the leader broadcasts the beacon frame (type PROTOCOL_TYPE_SYNC):
+@code
+offset  size  value
+0       2     Random number generator seed of the mood lamp logic instances
+2       4     Ticks handled by the mood lamp logic instances since their initialization by the seed
+@endcode
+Mood lamp logic is deterministic: instances initialized by the same seed and handled for the same 
+number of ticks have the same state (the same random numbers are taken in the same order). So 
+the follower, which receives a beacon with a new seed (or loses phase for more than 
+SYNC_RESYNC_TICKS ticks), initializes its random number generator and instances by the seed and 
+catches up with the leader by advancing (see rgb_advance()) no more than SYNC_CATCHUP_TICKS per 
+main cycle pass. After that the follower measures its phase error by every beacon and corrects it 
+by extra advancing (it is behind the leader) or pausing (it is ahead of the leader).
+
+Phase skew is bounded by the clocks difference accumulated during SYNC_PERIOD ticks (about 20 
+ticks or 2.6ms for 2% HSI difference) and the beacon delivery jitter. Ticks of the timer scheduler 
+modes must be used (see @ref scheduler). Ticks of this module are color flow steps (see 
+scheduler_steps()), they are timer ticks at the default color flow speed. All lamps must have the 
+same configuration, and commands 
+which change the color flow directly (destination color, freeze) break the lockstep until the 
+next seed.
+@{
+*/
+
+#define SYNC_OFF                                0                               ///< Lamp is not synchronized
+#define SYNC_LEADER                             1                               ///< Lamp broadcasts beacons
+#define SYNC_FOLLOWER                           2                               ///< Lamp follows received beacons
+#define SYNC_ROLES_NUMBER                       3                               ///< Synchronization roles quantity
+#define SYNC_ROLE                               SYNC_OFF                        ///< Default synchronization role
+#define SYNC_PERIOD                             1024                            ///< Leader beacon period, ticks (~131ms)
+#define SYNC_LATENCY_TICKS                      8                               ///< Beacon delivery time, ticks (11 bytes at 115200 baud ~ 0.96ms)
+#define SYNC_RESYNC_TICKS                       8192                            ///< Phase error which restarts the follower from the beacon seed, ticks
+#define SYNC_CATCHUP_TICKS                      0x40000UL                       ///< Maximal catching up advance per main cycle pass, ticks
+#define SYNC_BEACON_SIZE                        6                               ///< Beacon frame payload length, bytes
+
+void sync_init();
+void sync_beacon(const uint8_t *payload);
+uint16_t sync_handle(uint16_t ticks);
+
+///@}
+
+#endif /* __SYNC_H__ */
@@ -0,0 +1,110 @@
+/**
+@file           telemetry.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists telemetry.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "telemetry.h"
+#include "protocol.h"
+#include "profiler.h"
+#include "mood_logic.h"
+#include "hal.h"
+#include "scheduler.h"
+
+/**
+@addtogroup telemetry
+@{
+*/
+
+#define TELEMETRY_PAYLOAD_SIZE                  (26 + 2 * PROFILER_SLOTS_NUMBER) ///< Telemetry frame payload length, bytes
+
+#if TELEMETRY_PAYLOAD_SIZE > PROTOCOL_MAX_PAYLOAD_SIZE
+ #error "Telemetry frame is longer than the maximal payload, receivers of the frame would lose synchronization"
+#endif
+
+static uint16_t tick_counter = 0;                                               ///< Ticks since power-on
+static uint16_t report_ticks = 0;                                               ///< Ticks since the last reporting
+static uint8_t dropped_frames = 0;                                              ///< Frames dropped because of transmitter buffer overflow
+
+/**
+@brief Big-endian word writer
+@param[out] buffer Destination pointer
+@param[in] value Word to be written
+@return Pointer to the next byte after written word
+*/
+static uint8_t *put_word(uint8_t *buffer, uint16_t value){
+  *buffer++ = (uint8_t) (value >> 8);
+  *buffer++ = (uint8_t) value;
+  return buffer;
+}
+
+/**
+@brief Telemetry handler
+@details Counts ticks and sends telemetry frame every TELEMETRY_PERIOD ticks (at the first call 
+after TELEMETRY_PERIOD ticks if the main cycle sleeps for several ticks). The first mood lamp 
+logic instance state is reported. Frame is put into 
+UART transmitter buffer and is sent in background. If there is not enough space in the buffer, 
+frame is dropped, so this function never blocks the main cycle.
+@param[in] ticks Ticks elapsed since the previous call
+@note This function should be called once per main cycle pass
+*/
+void telemetry_handle(uint16_t ticks){
+  uint8_t frame[TELEMETRY_PAYLOAD_SIZE + PROTOCOL_FRAME_OVERHEAD];
+  uint8_t *p = frame;
+  uint8_t checksum = 0;
+  tick_counter += ticks;
+  report_ticks += ticks;
+  if(report_ticks < TELEMETRY_PERIOD) return;                                   // Not a reporting tick
+  report_ticks = 0;
+  *p++ = PROTOCOL_SYNC_1;
+  *p++ = PROTOCOL_SYNC_2;
+  *p++ = PROTOCOL_TYPE_TELEMETRY;
+  *p++ = TELEMETRY_PAYLOAD_SIZE;
+  p = put_word(p, tick_counter);
+  for(uint8_t i = 0; i < 3; ++i){
+    p = put_word(p, get_current_color(&mood_engines[0], i));
+  }
+  for(uint8_t i = 0; i < 3; ++i){
+    p = put_word(p, get_destination_color(&mood_engines[0], i));
+  }
+  *p++ = get_color_scheme(&mood_engines[0]);
+  *p++ = dropped_frames;
+  p = put_word(p, get_tick_period_min());
+  p = put_word(p, get_tick_period_max());
+  p = put_word(p, get_scheduler_wakeups());
+  p = put_word(p, get_dmx_frames());
+  p = put_word(p, get_dmx_errors());
+  for(uint8_t i = 0; i < PROFILER_SLOTS_NUMBER; ++i){
+    p = put_word(p, get_profiler_slot_max(i));
+  }
+  if(p != &frame[sizeof(frame) - 1]) return;                                    // Payload does not match TELEMETRY_PAYLOAD_SIZE, frame is not sent
+  for(uint8_t i = 2; i < sizeof(frame) - 1; ++i){                               // Checksum covers type, length and payload
+    checksum ^= frame[i];
+  }
+  frame[sizeof(frame) - 1] = checksum;
+  if(uart_write(frame, sizeof(frame))){
+    profiler_reset();                                                           // Start new measurement window
+  }else if(dropped_frames < U8_MAX){
+    ++dropped_frames;
+  }
+}
+
+///@}
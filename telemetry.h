@@ -0,0 +1,59 @@
+/**
+@file           telemetry.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists telemetry interface.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <stm8s.h>
+
+/**
+@defgroup telemetry Telemetry
+@brief This module consists lamp state reporting over serial link
+@details Telemetry frame (type PROTOCOL_TYPE_TELEMETRY) payload:
+@code
+offset  size  value
+0       2     Tick counter
+2       6     Current color {R, G, B}
+8       6     Destination color {R, G, B}
+14      1     Color scheme
+15      1     Dropped telemetry frames counter
+16      2     Minimal tick period, cycles
+18      2     Maximal tick period, cycles
+20      2     CPU wakeups since the previous frame
+22      2     Latched DMX512 frames counter (wraps around)
+24      2     Dropped DMX512 frames counter
+26      2*N   Profiler slots maximal execution times, cycles
+@endcode
+N is PROFILER_SLOTS_NUMBER: the strip slot is reported only if the strip is enabled, so the payload 
+is 34 or 36 bytes long.
+@{
+*/
+
+#define TELEMETRY_PERIOD                        64                              ///< Telemetry frame is sent every TELEMETRY_PERIOD ticks
+
+void telemetry_handle(uint16_t ticks);
+
+///@}
+
+#endif /* __TELEMETRY_H__ */
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Mood lamp profiler benchmark.
+
+Configures the lamp by commands, collects the profiler slots of the telemetry
+frames (the profiler is reset after every frame, so every frame reports the
+worst case of its window) and prints the worst case of every slot for every
+benchmark case. The lamp is connected by a serial port or a pseudo-terminal
+attached to the simulator UART2, the timer scheduler mode is used, so every
+measurement window has the same number of ticks.
+
+Numbers are MCU cycles (Fmaster = 16MHz). The default configuration is
+restored at the end by resetting the lamp configuration fields touched by the
+cases.
+
+Usage: benchmark.py <device> [frames per case] [baudrate]
+"""
+
+import os
+import sys
+import termios
+import time
+
+from telemetry_decode import BAUDRATES, SYNC, TYPE_TELEMETRY, frames, words
+
+SLOTS = ("rgb_handle", "pwm_update", "output", "correction", "strip")
+SET_SCHEDULER = 0x1E
+SCHEDULER_TIMER = 1
+SCHEDULER_LOOP = 0
+SET_MATRIX = 0x16
+SET_BRIGHTNESS = 0x17
+SET_INTERPOLATION = 0x18
+SET_EASING = 0x19
+INTERPOLATIONS = ("linear", "hsv", "spline")
+EASINGS = ("linear", "smoothstep", "sine", "exponential")
+ONE = 0x4000                                            # Q2.14 matrix coefficient 1.0
+
+
+def matrix(*coefficients):
+    payload = []
+    for value in coefficients:
+        payload += list((value & 0xFFFF).to_bytes(2, "big"))
+    return payload
+
+
+IDENTITY = matrix(ONE, 0, 0, 0, ONE, 0, 0, 0, ONE)
+
+# Case name, list of (command type, payload) applied before the measurement
+CASES = [
+    ("default", []),
+    ("matrix diagonal", [(SET_MATRIX, matrix(ONE, 0, 0, 0, ONE * 7 // 8, 0, 0, 0, ONE * 3 // 4))]),
+    ("matrix full", [(SET_MATRIX, matrix(ONE, -ONE // 8, ONE // 8, ONE // 16, ONE, -ONE // 16,
+                                         -ONE // 8, ONE // 8, ONE))]),
+    ("matrix identity", [(SET_MATRIX, IDENTITY)]),
+    ("brightness ramp", [(SET_BRIGHTNESS, [0x00]), (SET_BRIGHTNESS, [0xFF])]),
+    ("brightness 50%", [(SET_BRIGHTNESS, [0x80])]),
+    ("brightness full", [(SET_BRIGHTNESS, [0xFF])]),
+]
+CASES += [("interpolation " + name, [(SET_INTERPOLATION, [mode]), (SET_EASING, [0])])
+          for mode, name in enumerate(INTERPOLATIONS)]
+CASES += [("hsv easing " + name, [(SET_INTERPOLATION, [1]), (SET_EASING, [curve])])
+          for curve, name in enumerate(EASINGS)]
+RESTORE = [(SET_MATRIX, IDENTITY), (SET_BRIGHTNESS, [0xFF]), (SET_INTERPOLATION, [0]), (SET_EASING, [0])]
+
+
+def open_device(path, baudrate):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    if os.isatty(fd):
+        attrs = termios.tcgetattr(fd)
+        attrs[0] = attrs[1] = attrs[3] = 0              # Raw input and output, no echo
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attrs[4] = attrs[5] = BAUDRATES[baudrate]
+        attrs[6][termios.VMIN] = 1
+        attrs[6][termios.VTIME] = 0
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def send(fd, frame_type, payload):
+    body = bytes([frame_type, len(payload)]) + bytes(payload)
+    checksum = 0
+    for byte in body:
+        checksum ^= byte
+    os.write(fd, b"\x00" + SYNC + body + bytes([checksum]))    # Leading byte wakes the lamp from active-halt
+    time.sleep(0.05)
+
+
+def measure(stream, count):
+    """Returns worst cases of the profiler slots over count telemetry frames."""
+    worst = None
+    skip = 2                                            # Windows which may include the configuration change
+    for frame_type, payload in stream:
+        if frame_type != TYPE_TELEMETRY or len(payload) < 26:
+            continue
+        if skip:
+            skip -= 1
+            continue
+        slots = words(payload, 26, (len(payload) - 26) // 2)
+        worst = slots if worst is None else [max(a, b) for a, b in zip(worst, slots)]
+        count -= 1
+        if not count:
+            break
+    return worst or []
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 64
+    fd = open_device(sys.argv[1], int(sys.argv[3]) if len(sys.argv) > 3 else 115200)
+    stream = frames(fd)
+    send(fd, SET_SCHEDULER, [SCHEDULER_TIMER])
+    header = False
+    for name, commands in CASES:
+        for frame_type, payload in commands:
+            send(fd, frame_type, payload)
+        worst = measure(stream, count)
+        if not header:                                  # Strip slot is reported by STRIP_ENABLE builds only
+            print("{:24s}".format("case") + "".join("{:>12s}".format(name) for name in SLOTS[:len(worst)]))
+            header = True
+        print("{:24s}".format(name) + "".join("{:12d}".format(value) for value in worst), flush=True)
+    for frame_type, payload in RESTORE:
+        send(fd, frame_type, payload)
+    send(fd, SET_SCHEDULER, [SCHEDULER_LOOP])
+
+
+if __name__ == "__main__":
+    main()
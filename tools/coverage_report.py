@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Mood lamp destination colors coverage report.
+
+Draws random destination colors the same way as the firmware does in both
+sampling modes (color schemes with the default shares from mood_logic.h and
+the OKLab samples table from color.c, both driven by the firmware 16-bit
+xorshift generator) and reports how they cover the sRGB gamut in the OKLab
+space.
+
+Gamut is divided into OKLab cells, coverage is the part of gamut cells hit by
+the drawn colors. Edge share is the part of colors with at least two channels
+at zero or full value (RGB cube edges).
+
+Usage: coverage_report.py [draws]
+"""
+
+import math
+import os
+import re
+import sys
+
+from oklab_samples import gamut_samples, linear_srgb_to_oklab, value_to_oklab
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+CELL = 0.1
+U16_MAX = 0xFFFF
+
+
+class Xorshift:
+    """Firmware 16-bit xorshift generator (see xorshift.c)."""
+
+    def __init__(self, seed=1):
+        self.y16 = seed
+
+    def next(self):
+        self.y16 ^= (self.y16 << 13) & U16_MAX
+        self.y16 ^= self.y16 >> 9
+        self.y16 ^= (self.y16 << 7) & U16_MAX
+        return self.y16
+
+
+def read(name):
+    with open(os.path.join(ROOT, name)) as source:
+        return source.read()
+
+
+def scheme_shares():
+    names = ("ONE_COLOR", "TWO_COLORS", "THREE_COLORS", "ONE_COLOR_AND_RANDOM", "TWO_COLORS_AND_RANDOM")
+    header = read("mood_logic.h")
+    return [int(re.search(r"#define\s+RGB_{}_PROBABILITY\s+(\d+)".format(n), header).group(1)) for n in names]
+
+
+def oklab_table():
+    source = read("color.c")
+    body = source[source.index("oklab_samples[COLOR_OKLAB_SAMPLES][3] = {"):]
+    body = body[body.index("{") + 1:body.index("};")]
+    return [tuple(int(v) for v in t) for t in re.findall(r"\{\s*(\d+),\s*(\d+),\s*(\d+)\}", body)]
+
+
+def schemes_color(rng, shares):
+    share = rng.next() % sum(shares)
+    scheme = 0
+    while share >= shares[scheme]:
+        share -= shares[scheme]
+        scheme += 1
+    if scheme == 0:
+        color = [0, 0, 0]
+        color[rng.next() % 3] = U16_MAX
+    elif scheme == 1:
+        color = [U16_MAX] * 3
+        color[rng.next() % 3] = 0
+    elif scheme == 2:
+        color = [U16_MAX] * 3
+    elif scheme == 3:
+        color = [rng.next() for _ in range(3)]
+        color[rng.next() % 3] = U16_MAX
+    else:
+        color = [U16_MAX] * 3
+        color[rng.next() % 3] = rng.next()
+    return color
+
+
+def oklab_color(rng, table):
+    return [(v << 8) | v for v in table[rng.next() >> 8]]
+
+
+def cell(lab):
+    return tuple(math.floor(x / CELL) for x in lab)
+
+
+def report(name, colors, gamut_cells):
+    labs = [value_to_oklab(c, U16_MAX) for c in colors]
+    hit = {cell(lab) for lab in labs} & gamut_cells
+    edges = sum(1 for c in colors if sum(1 for v in c if v in (0, U16_MAX)) >= 2)
+    chroma = [math.hypot(lab[1], lab[2]) for lab in labs]
+    print("{:8s} distinct={:6d} coverage={:5.1f}% edges={:5.1f}% lightness={:.2f} chroma={:.2f}".format(
+        name, len({tuple(c) for c in colors}), 100 * len(hit) / len(gamut_cells), 100 * edges / len(colors),
+        sum(lab[0] for lab in labs) / len(labs), sum(chroma) / len(chroma)))
+
+
+def main():
+    draws = int(sys.argv[1]) if len(sys.argv) > 1 else 10000
+    gamut_cells = {cell(lab) for lab, _ in gamut_samples(50000, 2)}
+    gamut_cells |= {cell(linear_srgb_to_oklab(r, g, b)) for r in (0, 1) for g in (0, 1) for b in (0, 1)}
+    shares = scheme_shares()
+    table = oklab_table()
+    rng = Xorshift()
+    report("schemes", [schemes_color(rng, shares) for _ in range(draws)], gamut_cells)
+    rng = Xorshift()
+    report("oklab", [oklab_color(rng, table) for _ in range(draws)], gamut_cells)
+    print("{} draws, {} gamut cells of {} OKLab units".format(draws, len(gamut_cells), CELL))
+
+
+if __name__ == "__main__":
+    main()
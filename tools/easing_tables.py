@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+"""Mood lamp easing tables generator.
+
+Prints the easing curves tables of easing.c. Every table has 256 entries:
+entry i is the eased fraction of the transition at progress i / 256, scaled to
+0...65535 (the end point 1.0 is implied by the firmware).
+
+Usage: easing_tables.py > tables.txt
+"""
+
+import math
+
+ENTRIES = 256
+PER_LINE = 8
+
+
+def smoothstep(t):
+    return t * t * (3 - 2 * t)
+
+
+def sine(t):
+    return (1 - math.cos(math.pi * t)) / 2
+
+
+def exponential(t):
+    def raw(x):
+        return 2 ** (20 * x - 10) / 2 if x < 0.5 else (2 - 2 ** (10 - 20 * x)) / 2
+    return (raw(t) - raw(0)) / (raw(1) - raw(0))
+
+
+CURVES = (("Smoothstep", smoothstep), ("Sine in/out", sine), ("Exponential in/out", exponential))
+
+
+def main():
+    for index, (name, curve) in enumerate(CURVES):
+        values = [round(curve(i / ENTRIES) * 65535) for i in range(ENTRIES)]
+        print("  {                                                                             // " + name)
+        for start in range(0, ENTRIES, PER_LINE):
+            line = ", ".join("{:5d}".format(v) for v in values[start:start + PER_LINE])
+            last = start + PER_LINE >= ENTRIES
+            print("    " + line + ("" if last else ","))
+        print("  }" + ("" if index == len(CURVES) - 1 else ","))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,78 @@
+/**
+@file           color_check.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists host check of the color spaces conversion.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/*
+Build and run from the repository root:
+  cc -std=c99 -D__ICCSTM8__ -Itools/host -I. tools/host/color_check.c color.c -o color_check
+  ./color_check
+*/
+
+#include <stdio.h>
+#include "color.h"
+
+/**
+@brief Primaries and secondaries with their hues (the hue circle is the whole 16-bit range)
+*/
+static const struct{
+  const char *name;
+  uint16_t rgb[3];
+  uint16_t hue;
+} colors[] = {
+  {"red",     {U16_MAX, 0, 0},             0},
+  {"yellow",  {U16_MAX, U16_MAX, 0},       0x10000L / 6},
+  {"green",   {0, U16_MAX, 0},             0x20000L / 6},
+  {"cyan",    {0, U16_MAX, U16_MAX},       0x30000L / 6},
+  {"blue",    {0, 0, U16_MAX},             0x40000L / 6},
+  {"magenta", {U16_MAX, 0, U16_MAX},       0x50000L / 6}
+};
+
+int main(){
+  uint16_t hsv[3];
+  uint16_t rgb[3];
+  int failures = 0;
+  for(unsigned i = 0; i < sizeof(colors) / sizeof(colors[0]); ++i){
+    for(uint32_t value = U16_MAX; value >= 0x100; value >>= 1){                 // Full and dimmed colors
+      uint16_t scaled[3];
+      for(uint8_t j = 0; j < 3; ++j){
+        scaled[j] = colors[i].rgb[j] ? (uint16_t) value : 0;
+      }
+      rgb_to_hsv(scaled, hsv);
+      hsv_to_rgb(hsv, rgb);
+      int ok = (hsv[0] == colors[i].hue) && (hsv[1] == U16_MAX) && (hsv[2] == value);
+      for(uint8_t j = 0; j < 3; ++j){
+        int error = (int) rgb[j] - scaled[j];
+        if((error < -6) || (error > 6)) ok = 0;                                 // Hue step is 6 / 65536 of a sextant
+      }
+      if(!ok){
+        printf("FAIL %s %04X: hsv %04X/%04X/%04X (hue %04X expected), rgb %04X/%04X/%04X\n", 
+          colors[i].name, (unsigned) value, hsv[0], hsv[1], hsv[2], colors[i].hue, rgb[0], rgb[1], 
+          rgb[2]);
+        ++failures;
+      }
+    }
+  }
+  printf("%s: %d failures\n", failures ? "FAIL" : "OK", failures);
+  return failures ? 1 : 0;
+}
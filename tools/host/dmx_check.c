@@ -0,0 +1,211 @@
+/**
+@file           dmx_check.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists host check of the DMX512 break detection and frames parsing.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*
+Build and run from the repository root:
+  cc -std=c99 -D__ICCSTM8__ -Itools/host -I. tools/host/dmx_check.c -o dmx_check
+  ./dmx_check
+
+HAL is compiled into this program with the peripheral registers redirected into memory, and UART2 
+receiver interrupt handler is fed by byte sequences: real DMX512 frames, false breaks (zero 
+command byte with framing error) followed by command bytes or by a frame-like byte sequence, 
+alternate start code frames and damaged slots. Only the interrupt handler logic is checked, its 
+cycle budget is not (see hal.h).
+*/
+
+#include <stdio.h>
+#include <stm8s.h>
+
+#define CHECK_PERIPHERAL(name)                  static name##_TypeDef check_##name; ///< Peripheral registers in memory
+CHECK_PERIPHERAL(AWU)
+CHECK_PERIPHERAL(CFG)
+CHECK_PERIPHERAL(CLK)
+CHECK_PERIPHERAL(EXTI)
+CHECK_PERIPHERAL(FLASH)
+CHECK_PERIPHERAL(GPIO)
+CHECK_PERIPHERAL(I2C)
+CHECK_PERIPHERAL(SPI)
+CHECK_PERIPHERAL(TIM1)
+CHECK_PERIPHERAL(TIM2)
+CHECK_PERIPHERAL(TIM3)
+CHECK_PERIPHERAL(TIM4)
+CHECK_PERIPHERAL(UART2)
+static GPIO_TypeDef check_GPIOD;
+
+#undef AWU
+#undef CFG
+#undef CLK
+#undef EXTI
+#undef FLASH
+#undef GPIOC
+#undef GPIOD
+#undef I2C
+#undef SPI
+#undef TIM1
+#undef TIM2
+#undef TIM3
+#undef TIM4
+#undef UART2
+#define AWU                                     (&check_AWU)
+#define CFG                                     (&check_CFG)
+#define CLK                                     (&check_CLK)
+#define EXTI                                    (&check_EXTI)
+#define FLASH                                   (&check_FLASH)
+#define GPIOC                                   (&check_GPIO)
+#define GPIOD                                   (&check_GPIOD)
+#define I2C                                     (&check_I2C)
+#define SPI                                     (&check_SPI)
+#define TIM1                                    (&check_TIM1)
+#define TIM2                                    (&check_TIM2)
+#define TIM3                                    (&check_TIM3)
+#define TIM4                                    (&check_TIM4)
+#define UART2                                   (&check_UART2)
+
+#include "hal.c"
+
+#define CHECK_BREAK                             0x100                           ///< Byte sequence item: zero byte with framing error
+#define CHECK_DAMAGED                           0x200                           ///< Byte sequence item flag: framing error
+#define CHECK_END                               0xFFFF                          ///< Byte sequence end
+
+static int failures = 0;
+
+/**
+@brief Byte sequence receiving by UART2 receiver interrupt handler
+@param[in] bytes Byte sequence (bytes, CHECK_BREAK and CHECK_DAMAGED flagged bytes), CHECK_END 
+terminated
+*/
+static void check_receive(const uint16_t *bytes){
+  for(; *bytes != CHECK_END; ++bytes){
+    check_UART2.SR = (*bytes & (CHECK_BREAK | CHECK_DAMAGED)) ? UART2_SR_FE : 0;
+    check_UART2.DR = (*bytes & CHECK_BREAK) ? 0 : (uint8_t) *bytes;
+    uart2_rx_irq_handler();
+  }
+}
+
+/**
+@brief DMX512 frame receiving: break, start code and the specified number of slots
+@param[in] start_code Start code
+@param[in] slots Slots quantity
+@param[in] base The first slot value, slot n has value base + n
+*/
+static void check_frame(uint8_t start_code, uint16_t slots, uint8_t base){
+  uint16_t bytes[] = {CHECK_BREAK, start_code, CHECK_END};
+  check_receive(bytes);
+  for(uint16_t n = 1; n <= slots; ++n){
+    uint16_t slot[] = {(uint8_t) (base + n), CHECK_END};
+    check_receive(slot);
+  }
+}
+
+/**
+@brief Receiver state check
+@param[in] name Case name
+@param[in] active Expected DMX512 mode flag
+@param[in] frames Expected latched frames counter
+*/
+static void check_state(const char *name, uint8_t active, uint16_t frames){
+  uint16_t divider = active ? HAL_DMX_BAUDRATE_DIVIDER : HAL_UART_BAUDRATE_DIVIDER;
+  uint8_t brr1 = (uint8_t) (divider >> 4);
+  if((dmx_is_active() != active) || (get_dmx_frames() != frames) || (check_UART2.BRR1 != brr1)){
+    printf("FAIL %s: active %u (%u expected), frames %u (%u expected), BRR1 %02X (%02X expected)\n", 
+      name, dmx_is_active(), active, get_dmx_frames(), frames, check_UART2.BRR1, brr1);
+    ++failures;
+  }
+}
+
+/**
+@brief Receiver reset: command mode, the specified start address, counters are cleared
+@param[in] address DMX512 start address
+*/
+static void check_reset(uint16_t address){
+  dmx_stop();
+  dmx_set_address(address);
+  dmx_frames = 0;
+  dmx_errors = 0;
+  uart_rx_head = 0;
+  uart_rx_tail = 0;
+  uart_set_divider(HAL_UART_BAUDRATE_DIVIDER);
+}
+
+int main(){
+  static const uint16_t command[] = {CHECK_BREAK, 0xA5 | CHECK_DAMAGED, 0x5A, 0x10, CHECK_END};
+  static const uint16_t frame_like[] = {CHECK_BREAK, 0x00, 0x01, 0x02, 0x03, 0x04, CHECK_END};
+  uint16_t address = 10;
+
+  check_reset(address);                                                         // Real DMX512 signal
+  check_frame(0, 512, 0);
+  check_state("first frame is not latched", 1, 0);
+  check_frame(0, 512, 0x40);
+  check_state("second frame is latched", 1, 1);
+  for(uint8_t i = 0; i < HAL_DMX_SLOTS; ++i){
+    uint8_t value = (uint8_t) (0x40 + address + i);
+    if(pwm_values[i] != ((uint16_t) value) * value + 2 * value){
+      printf("FAIL channel %u: %04X\n", i, pwm_values[i]);
+      ++failures;
+    }
+  }
+  check_frame(0x17, 512, 0);
+  check_state("alternate start code is skipped", 1, 1);
+  check_frame(0, address, 0);                                                   // Damaged slot before the used ones
+  check_receive((const uint16_t []) {0x55 | CHECK_DAMAGED, CHECK_END});
+  check_state("damaged frame is dropped", 1, 1);
+  if(get_dmx_errors() != 1){
+    printf("FAIL dropped frames: %u\n", get_dmx_errors());
+    ++failures;
+  }
+  check_frame(0, address + HAL_DMX_SLOTS - 2, 0);                               // Short frame, then a full one
+  check_frame(0, 512, 0);
+  check_state("short frame is not latched", 1, 2);
+
+  check_reset(address);                                                         // False break followed by command bytes
+  check_receive(command);
+  check_state("false break, command bytes", 0, 0);
+
+  check_reset(address);                                                         // False break followed by a frame-like sequence
+  check_receive(frame_like);
+  check_frame(0, address + HAL_DMX_SLOTS, 0);
+  check_state("false break, frame-like bytes", 1, 0);
+
+  check_reset(address);                                                         // Alternate start code of the first frame
+  check_frame(0xCC, 512, 0);
+  check_state("alternate start code before qualification", 0, 0);
+
+  check_reset(address);                                                         // Short first frame
+  check_frame(0, address + HAL_DMX_SLOTS - 2, 0);
+  check_frame(0, 512, 0);
+  check_state("short first frame", 1, 0);
+
+  check_reset(0);                                                               // DMX512 reception is disabled
+  check_receive(frame_like);
+  check_state("reception is disabled", 0, 0);
+  if(uart_rx_head != 6){
+    printf("FAIL command bytes received: %u\n", uart_rx_head);
+    ++failures;
+  }
+
+  printf("%s: %d failures\n", failures ? "FAIL" : "OK", failures);
+  return failures ? 1 : 0;
+}
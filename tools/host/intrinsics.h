@@ -0,0 +1,42 @@
+/**
+@file           intrinsics.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists host build stubs of the IAR STM8 intrinsics and keywords.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __INTRINSICS_H__
+#define __INTRINSICS_H__
+
+#define __interrupt
+#define __near
+#define __far
+#define __tiny
+#define __eeprom
+
+#define __enable_interrupt()
+#define __disable_interrupt()
+#define __no_operation()
+#define __trap()
+#define __wait_for_interrupt()
+#define __halt()
+
+#endif /* __INTRINSICS_H__ */
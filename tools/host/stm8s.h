@@ -0,0 +1,39 @@
+/**
+@file           stm8s.h
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists host build wrapper of the STM8S header.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/*
+Host checks are built with this directory ahead of the repository root in the include path. 32-bit 
+types of the STM8S header are long, which is 64-bit on the LP64 hosts, so they are declared as int 
+here to keep the target arithmetics (and its overflows) on the host.
+*/
+
+#ifndef __HOST_STM8S_H__
+#define __HOST_STM8S_H__
+
+#define long int
+#include "../../stm8s.h"
+#undef long
+
+#endif /* __HOST_STM8S_H__ */
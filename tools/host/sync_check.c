@@ -0,0 +1,266 @@
+/**
+@file           sync_check.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists host check of the multi-lamp synchronization.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*
+Build and run from the repository root:
+  cc -std=c99 -O2 -D__ICCSTM8__ -DMOOD_ENGINES_NUMBER=2 -Itools/host -I. tools/host/sync_check.c \
+    mood_logic.c color.c easing.c palette.c xorshift.c -o sync_check
+  ./sync_check [seconds]
+
+Every lamp is a separate process (the firmware state is static) with its own clock rate: the 
+leader (1.0) and followers (1.02, 0.98 and 1.005, the last one is switched on at one sixth of the 
+run and catches up from scratch). Processes are connected to the harness by socket pairs and run 
+the firmware main cycle in the timer scheduler mode (one pass per tick) in 1ms real time slices. 
+Leader TX bytes are delivered to the followers RX in the first slice after their arrival time 
+(87us per byte at 115200 baud) and are parsed as the command handler does. Epoch skew and color 
+difference of all instances are measured against the leader after the late follower catch-up. 
+MOOD_ENGINES_NUMBER may be set to 1 or more: instances share the random numbers generator.
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "mood_logic.h"
+#include "config.h"
+#include "xorshift.h"
+#include "protocol.h"
+#include "hal.h"
+#include "sync.c"                                                               // Static synchronization state is inspected
+
+#define CHECK_LAMPS                             4                               ///< Lamps quantity, the first one is the leader
+#define CHECK_SLICE_US                          1000                            ///< Real time slice, us
+#define CHECK_TICK_US                           128                             ///< Tick period, us
+#define CHECK_BYTE_US                           87                              ///< UART byte time at 115200 baud, us
+#define CHECK_TX_SIZE                           64                              ///< Lamp TX buffer size per slice, bytes
+
+/**
+@brief Harness to lamp message: ticks of the slice and RX bytes received before them
+*/
+typedef struct{
+  long ticks;                                                                   ///< Ticks of the slice (negative - exit)
+  uint8_t length;                                                               ///< RX bytes quantity
+  uint8_t data[CHECK_TX_SIZE];                                                  ///< RX bytes
+}check_request_t;
+
+/**
+@brief Lamp to harness message: state after the slice and TX bytes sent during it
+*/
+typedef struct{
+  uint32_t epoch;                                                               ///< Ticks handled by instances since the seed (see sync.c)
+  uint16_t color[MOOD_ENGINES_NUMBER][3];                                       ///< Instances current colors
+  uint8_t length;                                                               ///< TX bytes quantity
+  uint8_t data[CHECK_TX_SIZE];                                                  ///< TX bytes
+}check_reply_t;
+
+mood_config_t mood_config;
+
+static check_reply_t check_reply;                                               ///< Lamp reply being filled
+
+/**
+@brief UART transmitter stub, collects bytes of the slice
+@param[in] data Bytes to be sent
+@param[in] length Bytes quantity
+@return 1 - bytes are buffered, 0 - buffer is full
+*/
+uint8_t uart_write(const uint8_t *data, uint8_t length){
+  if(check_reply.length + length > CHECK_TX_SIZE) return 0;
+  memcpy(&check_reply.data[check_reply.length], data, length);
+  check_reply.length += length;
+  return 1;
+}
+
+/**
+@brief Received byte parsing (frame format of protocol.h, only beacons are executed)
+@param[in] data Received byte
+*/
+static void check_parse(uint8_t data){
+  static uint8_t frame[PROTOCOL_HEADER_SIZE + PROTOCOL_MAX_PAYLOAD_SIZE + 1];
+  static uint8_t position = 0;
+  frame[position] = data;
+  if(((position == 0) && (data != PROTOCOL_SYNC_1)) || ((position == 1) && (data != PROTOCOL_SYNC_2)) ||\
+    ((position == 3) && (data > PROTOCOL_MAX_PAYLOAD_SIZE))){
+    position = (data == PROTOCOL_SYNC_1) ? 1 : 0;
+    frame[0] = data;
+    return;
+  }
+  if((++position < PROTOCOL_HEADER_SIZE) || (position < PROTOCOL_FRAME_OVERHEAD + frame[3])) return;
+  uint8_t checksum = 0;
+  for(uint8_t i = 2; i < position - 1; ++i){
+    checksum ^= frame[i];
+  }
+  if((checksum == frame[position - 1]) && (frame[2] == PROTOCOL_TYPE_SYNC) && (frame[3] == SYNC_BEACON_SIZE)){
+    sync_beacon(&frame[PROTOCOL_HEADER_SIZE]);
+  }
+  position = 0;
+}
+
+/**
+@brief Lamp process: default configuration, the firmware main cycle in the timer scheduler mode
+@param[in] fd Socket to the harness
+@param[in] seed Random number generator seed
+@param[in] role Synchronization role
+*/
+static void check_lamp(int fd, uint16_t seed, uint8_t role){
+  static const uint8_t probabilities[] = {
+    RGB_ONE_COLOR_PROBABILITY,
+    RGB_TWO_COLORS_PROBABILITY,
+    RGB_THREE_COLORS_PROBABILITY,
+    RGB_ONE_COLOR_AND_RANDOM_PROBABILITY,
+    RGB_TWO_COLORS_AND_RANDOM_PROBABILITY
+  };
+  check_request_t request;
+  for(uint8_t i = 0; i < sizeof(probabilities); ++i){
+    mood_config.scheme_probabilities[i] = probabilities[i];
+    mood_config.scheme_probabilities_sum += probabilities[i];
+  }
+  mood_config.color_hold_ticks = RGB_COLOR_HOLD_TICKS;
+  mood_config.interpolation = RGB_INTERPOLATION;
+  mood_config.easing = RGB_EASING;
+  mood_config.pacing = RGB_PACING;
+  mood_config.sampling = RGB_SAMPLING;
+  mood_config.palette = RGB_PALETTE;
+  mood_config.min_distance = RGB_MIN_DISTANCE;
+  mood_config.sync_role = role;
+  uint16_xorshift_init(seed);
+  sync_init();
+  for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){
+    mood_engine_init(&mood_engines[i], 3 * i, HAL_PWM_NO_CHANNEL);
+  }
+  while(read(fd, &request, sizeof(request)) == sizeof(request) && (request.ticks >= 0)){
+    check_reply.length = 0;
+    for(uint8_t i = 0; i < request.length; ++i){
+      check_parse(request.data[i]);
+    }
+    for(long n = 0; n < request.ticks; ++n){                                    // Main cycle passes
+      uint16_t steps = sync_handle(1);
+      for(uint8_t i = 0; steps && (i < MOOD_ENGINES_NUMBER); ++i){
+        rgb_handle(&mood_engines[i]);
+      }
+    }
+    check_reply.epoch = sync_epoch;
+    for(uint8_t i = 0; i < MOOD_ENGINES_NUMBER; ++i){
+      for(uint8_t j = 0; j < 3; ++j){
+        check_reply.color[i][j] = get_current_color(&mood_engines[i], j);
+      }
+    }
+    if(write(fd, &check_reply, sizeof(check_reply)) != sizeof(check_reply)) break;
+  }
+  exit(0);
+}
+
+int main(int argc, char **argv){
+  static const double rates[CHECK_LAMPS] = {1.0, 1.02, 0.98, 1.005};
+  static const uint16_t seeds[CHECK_LAMPS] = {111, 222, 333, 444};
+  long slices = ((argc > 1) ? atol(argv[1]) : 600) * (1000000L / CHECK_SLICE_US);
+  long start[CHECK_LAMPS] = {0, 0, 0, slices / 6};                              // Slice of the lamp switching on
+  long ticks[CHECK_LAMPS] = {0};
+  int fd[CHECK_LAMPS];
+  uint8_t queue[CHECK_TX_SIZE];                                                 // Leader TX bytes on the line
+  long arrival[CHECK_TX_SIZE];                                                  // Their arrival times, us
+  uint8_t queued = 0;
+  long max_skew[CHECK_LAMPS] = {0};
+  long max_difference[CHECK_LAMPS] = {0};
+  double sum_difference[CHECK_LAMPS] = {0};
+  long measured = 0;
+  check_reply_t leader = {0};
+  for(uint8_t i = 0; i < CHECK_LAMPS; ++i){
+    int pair[2];
+    if(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, pair)) return 1;
+    fflush(stdout);
+    if(!fork()){
+      close(pair[0]);
+      check_lamp(pair[1], seeds[i], i ? SYNC_FOLLOWER : SYNC_LEADER);
+    }
+    close(pair[1]);
+    fd[i] = pair[0];
+  }
+  for(long slice = 0; slice < slices; ++slice){
+    long now = slice * CHECK_SLICE_US;
+    check_request_t request;
+    check_reply_t reply;
+    request.length = 0;
+    while(request.length < queued && arrival[request.length] <= now){           // Bytes which have arrived before the slice
+      request.data[request.length] = queue[request.length];
+      ++request.length;
+    }
+    queued -= request.length;
+    memmove(queue, &queue[request.length], queued);
+    memmove(arrival, &arrival[request.length], queued * sizeof(long));
+    for(uint8_t i = 0; i < CHECK_LAMPS; ++i){
+      long target = (long) ((now + CHECK_SLICE_US) * rates[i] / CHECK_TICK_US);
+      if(slice < start[i]){
+        ticks[i] = target;                                                      // Switched off lamp does not receive
+        continue;
+      }
+      request.ticks = target - ticks[i];
+      ticks[i] = target;
+      if(!i){
+        uint8_t length = request.length;
+        request.length = 0;
+        if(write(fd[i], &request, sizeof(request)) != sizeof(request)) return 1;
+        request.length = length;
+      }else if(write(fd[i], &request, sizeof(request)) != sizeof(request)){
+        return 1;
+      }
+      if(read(fd[i], &reply, sizeof(reply)) != sizeof(reply)) return 1;
+      if(!i){
+        leader = reply;
+        for(uint8_t j = 0; (j < reply.length) && (queued < CHECK_TX_SIZE); ++j){ // Sent at the slice end
+          queue[queued] = reply.data[j];
+          arrival[queued++] = now + CHECK_SLICE_US + (j + 1) * CHECK_BYTE_US;
+        }
+      }else if(slice >= slices / 3){                                            // After the late follower catch-up
+        long skew = labs((long) (int32_t) (reply.epoch - leader.epoch));
+        if(skew > max_skew[i]) max_skew[i] = skew;
+        for(uint8_t e = 0; e < MOOD_ENGINES_NUMBER; ++e){
+          for(uint8_t j = 0; j < 3; ++j){
+            long difference = labs((long) reply.color[e][j] - leader.color[e][j]);
+            if(difference > max_difference[i]) max_difference[i] = difference;
+            sum_difference[i] += difference;
+          }
+        }
+      }
+    }
+    if(slice >= slices / 3) ++measured;
+  }
+  for(uint8_t i = 0; i < CHECK_LAMPS; ++i){
+    check_request_t request = {-1, 0, {0}};
+    if(write(fd[i], &request, sizeof(request)) != sizeof(request)) return 1;
+    wait(NULL);
+  }
+  printf("instances %d, leader epoch %lu, measured %ld slices\n", MOOD_ENGINES_NUMBER, (unsigned long) leader.epoch, 
+    measured);
+  printf("follower  rate  max skew  max difference  mean difference\n");
+  for(uint8_t i = 1; i < CHECK_LAMPS; ++i){
+    printf("%8d %5.3f %9ld %15ld %16.1f\n", i, rates[i], max_skew[i], max_difference[i], 
+      sum_difference[i] / (3.0 * MOOD_ENGINES_NUMBER * measured));
+  }
+  return 0;
+}
@@ -0,0 +1,157 @@
+/**
+@file           wakeups_check.c
+@author         <a href="https://github.com/AntaresLab">AntaresLab</a>
+@version        1.0.1
+@date           19-October-2026
+@brief          This file consists host measurement of the tickless scheduler CPU wakeups.
+@copyright      COPYRIGHT(c) 2018 Sergey Starovoitov aka AntaresLab (https://github.com/AntaresLab)
+
+    This file is part of Mood_lamp.
+
+    Mood_lamp is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Mood_lamp is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Mood_lamp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/*
+Build and run from the repository root:
+  cc -std=c99 -O2 -D__ICCSTM8__ -Itools/host -I. tools/host/wakeups_check.c mood_logic.c color.c \
+    easing.c palette.c xorshift.c -o wakeups_check
+  ./wakeups_check [ticks]
+
+Mood lamp logic is run with the default configuration for the specified number of ticks (2M by 
+default, about 4.3 minutes) twice: every tick (the timer scheduler mode) and with tickless sleeps 
+until the next output change (see scheduler.c). CPU wakeups are counted as the firmware counts 
+them for telemetry: main cycle passes and tick timer interrupts. Timer period of the tickless 
+sleep is one tick after a pass and up to HAL_TICK_CHUNK_MAX ticks after that. Output levels of 
+the tickless run are compared with the timer mode run on every tick. Runs are repeated at full and 
+reduced master brightness, which is applied inside the linearization square and changes the 
+plateaus.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "mood_logic.h"
+#include "config.h"
+#include "xorshift.h"
+#include "hal.h"
+#include "scheduler.h"
+
+#define CHECK_SEED                              12345                           ///< Random number generator seed of both runs
+
+mood_config_t mood_config;
+
+/**
+@brief Output level of the color channel value (apparent brightness linearization and master 
+brightness, see output.c)
+@param[in] value Color channel value
+@return Output level
+*/
+static uint16_t check_level(uint16_t value){
+  uint32_t dimmed = value;
+  if(mood_config.brightness != U8_MAX) dimmed = (dimmed * mood_config.brightness) >> 8;
+  return (uint16_t) ((((uint32_t) value) * dimmed) >> 16);
+}
+
+/**
+@brief Default configuration setting
+@param[in] interpolation Interpolation mode
+@param[in] hold Color hold time, ticks
+@param[in] brightness Master brightness
+*/
+static void check_configure(uint8_t interpolation, uint32_t hold, uint8_t brightness){
+  static const uint8_t probabilities[] = {
+    RGB_ONE_COLOR_PROBABILITY,
+    RGB_TWO_COLORS_PROBABILITY,
+    RGB_THREE_COLORS_PROBABILITY,
+    RGB_ONE_COLOR_AND_RANDOM_PROBABILITY,
+    RGB_TWO_COLORS_AND_RANDOM_PROBABILITY
+  };
+  mood_config.scheme_probabilities_sum = 0;
+  for(uint8_t i = 0; i < sizeof(probabilities); ++i){
+    mood_config.scheme_probabilities[i] = probabilities[i];
+    mood_config.scheme_probabilities_sum += probabilities[i];
+  }
+  mood_config.color_hold_ticks = hold;
+  mood_config.brightness = brightness;
+  mood_config.interpolation = interpolation;
+  mood_config.easing = RGB_EASING;
+  mood_config.pacing = RGB_PACING;
+  mood_config.sampling = RGB_SAMPLING;
+  mood_config.palette = RGB_PALETTE;
+  mood_config.min_distance = RGB_MIN_DISTANCE;
+}
+
+/**
+@brief Timer and tickless runs comparison
+@param[in] interpolation Interpolation mode
+@param[in] hold Color hold time, ticks
+@param[in] brightness Master brightness
+@param[in] ticks Run length, ticks
+@param[out] reference Buffer of 3 * ticks output levels
+*/
+static void check_run(uint8_t interpolation, uint32_t hold, uint8_t brightness, long ticks, uint16_t *reference){
+  mood_engine_t *e = &mood_engines[0];
+  long passes = 0;
+  long interrupts = 0;
+  long mismatches = 0;
+  check_configure(interpolation, hold, brightness);
+  uint16_xorshift_init(CHECK_SEED);
+  mood_engine_init(e, 0, HAL_PWM_NO_CHANNEL);
+  for(long n = 0; n < ticks; ++n){                                              // Timer mode: every tick
+    rgb_handle(e);
+    for(uint8_t i = 0; i < 3; ++i){
+      reference[3 * n + i] = check_level(get_current_color(e, i));
+    }
+  }
+  uint16_xorshift_init(CHECK_SEED);
+  mood_engine_init(e, 0, HAL_PWM_NO_CHANNEL);
+  for(long n = 0; n < ticks; ++passes){                                         // Tickless mode
+    long sleep = passes ? rgb_ticks_to_change(e) : 1;
+    if(sleep > SCHEDULER_MAX_SLEEP) sleep = SCHEDULER_MAX_SLEEP;
+    if(sleep > ticks - n) sleep = ticks - n;
+    interrupts += 1 + (sleep - 1 + HAL_TICK_CHUNK_MAX - 1) / HAL_TICK_CHUNK_MAX;
+    for(long m = n; m < n + sleep - 1; ++m){                                    // Skipped ticks must keep the output
+      for(uint8_t i = 0; i < 3; ++i){
+        if(n && (reference[3 * m + i] != reference[3 * (n - 1) + i])) ++mismatches;
+      }
+    }
+    rgb_skip(e, (uint16_t) (sleep - 1));
+    rgb_handle(e);
+    n += sleep;
+    for(uint8_t i = 0; i < 3; ++i){
+      if(check_level(get_current_color(e, i)) != reference[3 * (n - 1) + i]) ++mismatches;
+    }
+  }
+  printf("%-13s %6lu %6u %9ld %9ld %9ld %6.1f%% %10ld\n", (interpolation == RGB_INTERPOLATION_LINEAR) ? 
+    "linear" : (interpolation == RGB_INTERPOLATION_HSV) ? "hsv" : "spline", (unsigned long) hold, brightness, 
+    2 * ticks, passes + interrupts, passes, 100.0 * (passes + interrupts) / (2 * ticks), mismatches);
+}
+
+int main(int argc, char **argv){
+  long ticks = (argc > 1) ? atol(argv[1]) : 2000000L;
+  uint16_t *reference = malloc(3 * sizeof(uint16_t) * ticks);
+  static const uint32_t holds[] = {0, RGB_COLOR_HOLD_TICKS, 10UL * RGB_COLOR_HOLD_TICKS};
+  static const uint8_t brightnesses[] = {U8_MAX, 190, 127, 64};
+  if(!reference) return 1;
+  printf("interpolation   hold bright    timer  tickless    passes  ratio mismatches\n");
+  for(uint8_t b = 0; b < sizeof(brightnesses); ++b){
+    for(uint8_t mode = 0; mode < RGB_INTERPOLATIONS_NUMBER; ++mode){
+      for(uint8_t i = 0; i < sizeof(holds) / sizeof(holds[0]); ++i){
+        check_run(mode, holds[i], brightnesses[b], ticks, reference);
+      }
+    }
+  }
+  free(reference);
+  return 0;
+}
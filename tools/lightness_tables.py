@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+"""Mood lamp lightness tables generator.
+
+Prints the lightness tables of color.c. Color channel value v produces the
+luminance Y = v^2 (quadratic output linearization, see output.h), apparent
+lightness follows the Stevens' power law l = Y^(1/3) = v^(2/3). Every table has
+256 entries: entry i is the function of i / 256, scaled to 0...65535 (the end
+point 1.0 is implied by the firmware).
+
+Usage: lightness_tables.py > tables.txt
+"""
+
+ENTRIES = 256
+PER_LINE = 8
+
+TABLES = (("Value to lightness", lambda x: x ** (2 / 3)), ("Lightness to value", lambda x: x ** 1.5))
+
+
+def main():
+    for index, (name, function) in enumerate(TABLES):
+        values = [round(function(i / ENTRIES) * 65535) for i in range(ENTRIES)]
+        print("  {                                                                             // " + name)
+        for start in range(0, ENTRIES, PER_LINE):
+            line = ", ".join("{:5d}".format(v) for v in values[start:start + PER_LINE])
+            last = start + PER_LINE >= ENTRIES
+            print("    " + line + ("" if last else ","))
+        print("  }" + ("" if index == len(TABLES) - 1 else ","))
+
+
+if __name__ == "__main__":
+    main()
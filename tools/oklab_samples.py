@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Mood lamp OKLab samples table generator.
+
+Prints the OKLab samples table of color.c: OKLAB_SAMPLES colors spread
+uniformly over the sRGB gamut in the OKLab space. Candidates are drawn
+uniformly in the OKLab box and rejected if they are out of gamut, then the
+table is selected from them by farthest point sampling, so every table entry
+covers the same OKLab volume.
+
+Table entries are color channel values (the lamp output luminance is the square
+of the value, see output.h), 8 bits per channel.
+
+Usage: oklab_samples.py [--list] > table.txt
+"""
+
+import math
+import random
+import sys
+
+OKLAB_SAMPLES = 256
+CANDIDATES = 20000
+PER_LINE = 4
+SEED = 1
+
+
+def oklab_to_linear_srgb(lightness, a, b):
+    l_ = lightness + 0.3963377774 * a + 0.2158037573 * b
+    m_ = lightness - 0.1055613458 * a - 0.0638541728 * b
+    s_ = lightness - 0.0894841775 * a - 1.2914855480 * b
+    l, m, s = l_ ** 3, m_ ** 3, s_ ** 3
+    return (4.0767416621 * l - 3.3077115913 * m + 0.2309699292 * s,
+            -1.2684380046 * l + 2.6097574011 * m - 0.3413193965 * s,
+            -0.0041960863 * l - 0.7034186147 * m + 1.7076147010 * s)
+
+
+def linear_srgb_to_oklab(r, g, b):
+    l = 0.4122214708 * r + 0.5363348632 * g + 0.0514459929 * b
+    m = 0.2119034982 * r + 0.6806995451 * g + 0.1073969566 * b
+    s = 0.0883024619 * r + 0.2817188376 * g + 0.6299787005 * b
+    l_, m_, s_ = (math.copysign(abs(x) ** (1 / 3), x) for x in (l, m, s))
+    return (0.2104542553 * l_ + 0.7936177850 * m_ - 0.0040720468 * s_,
+            1.9779984951 * l_ - 2.4285922050 * m_ + 0.4505937099 * s_,
+            0.0259040371 * l_ + 0.7827717662 * m_ - 0.8086757660 * s_)
+
+
+def value_to_oklab(rgb, maximum):
+    """Lamp color channel values to OKLab (output luminance is the square of the value)."""
+    return linear_srgb_to_oklab(*((c / maximum) ** 2 for c in rgb))
+
+
+def gamut_samples(count, seed):
+    rng = random.Random(seed)
+    samples = []
+    while len(samples) < count:
+        lab = (rng.uniform(0, 1), rng.uniform(-0.4, 0.4), rng.uniform(-0.4, 0.4))
+        rgb = oklab_to_linear_srgb(*lab)
+        if all(0 <= c <= 1 for c in rgb):
+            samples.append((lab, rgb))
+    return samples
+
+
+def farthest_points(samples, count):
+    chosen = [samples[0]]
+    distance = [math.dist(s[0], chosen[0][0]) for s in samples]
+    while len(chosen) < count:
+        index = max(range(len(samples)), key=distance.__getitem__)
+        chosen.append(samples[index])
+        for i, s in enumerate(samples):
+            distance[i] = min(distance[i], math.dist(s[0], samples[index][0]))
+    return chosen
+
+
+def table():
+    chosen = farthest_points(gamut_samples(CANDIDATES, SEED), OKLAB_SAMPLES)
+    return [tuple(round(math.sqrt(c) * 255) for c in rgb) for _, rgb in chosen]
+
+
+def main():
+    values = table()
+    if "--list" in sys.argv:
+        for rgb in values:
+            print(*rgb)
+        return
+    for start in range(0, OKLAB_SAMPLES, PER_LINE):
+        line = ", ".join("{{{:3d}, {:3d}, {:3d}}}".format(*rgb) for rgb in values[start:start + PER_LINE])
+        last = start + PER_LINE >= OKLAB_SAMPLES
+        print("  " + line + ("" if last else ","))
+
+
+if __name__ == "__main__":
+    main()
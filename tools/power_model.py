@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Mood lamp MCU supply current model.
+
+Draws destination colors the same way as the firmware does in the color
+schemes sampling mode (see coverage_report.py), builds the stepping mode
+timeline of transitions (one value step per tick) and holds, and estimates the
+average MCU supply current and the CPU wakeups rate of every scheduler mode
+(see scheduler.h). Strip (LED) current is not included.
+
+Timing constants are read from the firmware headers. Currents are typical
+STM8S105 datasheet values at 25C and should be replaced by values measured on
+the particular board. Main cycle pass cost can be taken from the telemetry
+profiler slots.
+
+Usage: power_model.py [colors] [pass_cycles] [hold_ticks]
+"""
+
+import os
+import re
+import sys
+
+from coverage_report import U16_MAX, Xorshift, scheme_shares, schemes_color
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+F_MASTER = 16e6
+I_RUN = 7.4e-3                                  # Run mode, 16MHz HSI, code from flash, all peripherals clocked
+I_WAIT = 1.65e-3                                # Wait mode, 16MHz HSI, all peripherals clocked
+I_ACTIVE_HALT = 11e-6                           # Active-halt mode, main voltage regulator and flash memory are off
+T_WAKEUP = 50e-6                                # Active-halt mode wakeup time (run mode current is assumed)
+ISR_CYCLES = 60                                 # Timer interrupt handler cost, MCU cycles
+STATIC_MARGIN_LEVEL = U16_MAX - 64              # HAL_PWM_STATIC_MARGIN
+
+
+def define(name, header):
+    with open(os.path.join(ROOT, header)) as source:
+        return int(re.search(r"#define\s+{}\s+(\d+)".format(name), source.read()).group(1))
+
+
+def timeline(colors):
+    """Returns (transition ticks, static hold count, hold count) of the color flow."""
+    rng = Xorshift()
+    shares = scheme_shares()
+    current = [0, 0, 0]
+    transition = 0
+    static_holds = 0
+    for _ in range(colors):
+        destination = schemes_color(rng, shares)
+        transition += max(abs(d - c) for d, c in zip(destination, current))
+        levels = [(v * v) >> 16 for v in destination]
+        static_holds += all(l == 0 or l >= STATIC_MARGIN_LEVEL for l in levels)
+        current = destination
+    return transition, static_holds, colors
+
+
+def main():
+    colors = int(sys.argv[1]) if len(sys.argv) > 1 else 1000
+    pass_cycles = int(sys.argv[2]) if len(sys.argv) > 2 else 1500
+    hold = int(sys.argv[3]) if len(sys.argv) > 3 else define("RGB_COLOR_HOLD_TICKS", "mood_logic.h")
+    tick = (1 << define("HAL_TICK_PRESCALER", "hal.h")) * define("HAL_TICK_COUNTS", "hal.h") / F_MASTER
+    chunk = define("HAL_TICK_CHUNK_MAX", "hal.h")
+    awu = define("HAL_AWU_TICKS", "hal.h")
+    max_sleep = define("SCHEDULER_MAX_SLEEP", "scheduler.h")
+    transition, static_holds, holds = timeline(colors)
+    ticks = transition + holds * hold
+    duration = ticks * tick
+    t_pass = pass_cycles / F_MASTER
+    t_isr = ISR_CYCLES / F_MASTER
+
+    def wait_period(active_ticks, sleep_ticks):
+        """Charge and wakeups of ticks which wake the CPU every tick and of wait mode sleeping."""
+        wakeups = 2 * active_ticks + sleep_ticks / chunk + sleep_ticks / max_sleep
+        active = active_ticks * (t_pass + t_isr) + sleep_ticks / chunk * t_isr + sleep_ticks / max_sleep * t_pass
+        return active * I_RUN + ((active_ticks + sleep_ticks) * tick - active) * I_WAIT, wakeups
+
+    modes = {"loop": (duration * I_RUN, ticks), "timer": wait_period(ticks, 0),
+             "tickless": wait_period(transition, holds * hold)}
+    charge, wakeups = wait_period(transition, (holds - static_holds) * hold)
+    halt_ticks = static_holds * hold
+    halts = halt_ticks / awu
+    active = halts * (T_WAKEUP + t_isr) + halt_ticks / max_sleep * t_pass
+    charge += active * I_RUN + (halt_ticks * tick - active) * I_ACTIVE_HALT
+    modes["halt"] = (charge, wakeups + halts + halt_ticks / max_sleep)
+    for name, (charge, wakeups) in modes.items():
+        print("{:8s} current={:6.3f}mA wakeups={:9.0f}/min".format(name, 1e3 * charge / duration,
+                                                                      60 * wakeups / duration))
+    print("{} colors, {:.0f}% holds with static outputs, {:.0f}% of time in holds, {:.1f} hours".format(
+        colors, 100 * static_holds / holds, 100 * holds * hold / ticks, duration / 3600))
+
+
+if __name__ == "__main__":
+    main()
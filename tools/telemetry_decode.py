@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Mood lamp telemetry decoder.
+
+Reads the lamp serial stream from a serial port, a pseudo-terminal attached to
+the simulator UART2 or a captured binary file and prints decoded telemetry
+frames (see protocol.h and telemetry.h for the frame format).
+
+When reading a serial port in the timer scheduler modes, lamp clock error is
+estimated by comparing the telemetry tick counter with the host clock (the tick
+is 128us), it shows the HSI error to be corrected by the HSI trimming command.
+
+Usage: telemetry_decode.py <device or file> [baudrate]
+"""
+
+import os
+import sys
+import termios
+import time
+
+SYNC = b"\xA5\x5A"
+TYPE_TELEMETRY = 0x01
+SCHEMES = ("one", "two", "three", "one+random", "two+random", "command", "oklab", "palette")
+TICK = 128e-6
+CLOCK_WINDOW = 10.0                                     # Minimal clock error measurement time, seconds
+BAUDRATES = {9600: termios.B9600, 57600: termios.B57600, 115200: termios.B115200}
+
+
+def open_stream(path, baudrate):
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        attrs = termios.tcgetattr(fd)
+        attrs[0] = 0                                    # iflag: raw input
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attrs[3] = 0                                    # lflag: non-canonical, no echo
+        attrs[4] = attrs[5] = BAUDRATES[baudrate]
+        attrs[6][termios.VMIN] = 1
+        attrs[6][termios.VTIME] = 0
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def frames(fd):
+    """Yields (type, payload) tuples of frames with valid checksums."""
+    buffer = b""
+    while True:
+        chunk = os.read(fd, 256)
+        if not chunk:
+            return
+        buffer += chunk
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                buffer = buffer[-1:]
+                break
+            buffer = buffer[start:]
+            if len(buffer) < 4:
+                break
+            length = buffer[3]
+            if len(buffer) < 5 + length:
+                break
+            body = buffer[2:4 + length]
+            checksum = 0
+            for byte in body:
+                checksum ^= byte
+            if checksum == buffer[4 + length]:
+                yield body[0], body[2:]
+                buffer = buffer[5 + length:]
+            else:
+                buffer = buffer[1:]                     # False synchronization, resynchronize
+
+
+def words(payload, offset, count):
+    return [int.from_bytes(payload[offset + 2 * i:offset + 2 * i + 2], "big") for i in range(count)]
+
+
+def decode_telemetry(payload):
+    tick, = words(payload, 0, 1)
+    current = words(payload, 2, 3)
+    destination = words(payload, 8, 3)
+    scheme = payload[14]
+    dropped = payload[15]
+    period_min, period_max, wakeups = words(payload, 16, 3)
+    dmx_frames, dmx_errors = words(payload, 22, 2)
+    slots = words(payload, 26, (len(payload) - 26) // 2)
+    jitter = period_max - period_min if period_max >= period_min else 0
+    return ("tick={:5d} cur={} dst={} scheme={} period={}..{} jitter={} dropped={} wakeups={} "
+            "dmx={}/{} slots={}".format(
+        tick, "/".join("{:04X}".format(c) for c in current),
+        "/".join("{:04X}".format(c) for c in destination),
+        SCHEMES[scheme] if scheme < len(SCHEMES) else scheme,
+        period_min, period_max, jitter, dropped, wakeups, dmx_frames, dmx_errors, slots))
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    fd = open_stream(sys.argv[1], int(sys.argv[2]) if len(sys.argv) > 2 else 115200)
+    live = os.isatty(fd)
+    start = None
+    ticks = 0
+    for frame_type, payload in frames(fd):
+        if frame_type == TYPE_TELEMETRY and len(payload) >= 26:
+            line = decode_telemetry(payload)
+            tick, = words(payload, 0, 1)
+            if live and start is None:
+                start = time.monotonic()
+            elif live:
+                ticks += (tick - last_tick) & 0xFFFF
+                elapsed = time.monotonic() - start
+                if elapsed >= CLOCK_WINDOW:
+                    line += " clock={:+.2f}%".format(100 * (ticks * TICK / elapsed - 1))
+            last_tick = tick
+            print(line, flush=True)
+
+
+if __name__ == "__main__":
+    main()